@@ -0,0 +1,795 @@
+#pragma once
+#include <algorithm>    // min(), swap()
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t, uint16_t
+#include <cstring>      // memmove()
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>  // enable_if, is_integral, make_unsigned
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define ADAPTIVE_RADIX_TREE_USING_SSE2
+#endif
+
+// An Adaptive Radix Tree (Leis, Kemper, and Neumann, "The Adaptive Radix Tree: ARTful Indexing for Main-Memory Databases",
+// ICDE 2013).  Keys are treated as strings of bytes and each inner node branches on one byte, so a lookup costs O(key length)
+// byte comparisons no matter how many keys are stored, and a long prefix shared by many keys is examined once rather than
+// once per level as BinarySearchTree's operator< does.
+//
+// Inner nodes come in four sizes chosen by how many children they have:
+//     Node4    up to   4 children, sorted key bytes searched linearly
+//     Node16   up to  16 children, sorted key bytes searched with one SSE2 compare
+//     Node48   up to  48 children, 256 entry byte -> slot index
+//     Node256  up to 256 children, indexed directly by byte
+// Nodes grow and shrink between sizes as children are added and removed.  Runs of single-child nodes are collapsed into a
+// compressed prefix_ stored in the node below them (path compression).  A key that ends at an inner node (because it is a
+// proper prefix of other keys) is stored in that node's terminal_ leaf.
+//
+// Keys are converted to bytes by RadixKeyTraits:  std::string keys are used as is, and integer keys are stored big-endian
+// (with the sign bit flipped for signed types) so that byte order matches numeric order.  Leaves keep only those bytes, and
+// RadixKeyTraits decodes them back into a Key when a traversal hands keys out.  The interface mirrors BinarySearchTree.
+// Duplicate keys are not allowed:  inserting an existing key replaces its value.
+
+
+/*******************************************************************************
+**  Key to byte string conversions
+*******************************************************************************/
+template <typename Key, typename Enable = void>
+struct RadixKeyTraits;                                                     // Intentionally not defined:  specialize encode() and decode() for other key types
+
+template <>
+struct RadixKeyTraits<std::string> {
+  static const std::string & encode( const std::string & key   ) { return key;   }   // no copy:  strings already are bytes
+  static const std::string & decode( const std::string & bytes ) { return bytes; }
+};
+
+template <typename Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value>::type> {
+  static std::string encode( Key key )
+  {
+    using Unsigned = typename std::make_unsigned<Key>::type;
+
+    auto bits = static_cast<Unsigned>( key );
+    if( std::is_signed<Key>::value ) bits ^= Unsigned( 1 ) << ( sizeof( Key ) * 8 - 1 );   // negative numbers sort first
+
+    std::string bytes( sizeof( Key ), '\0' );
+    for( size_t i = sizeof( Key ); i-- > 0; bits >>= 8 )  bytes[i] = static_cast<char>( bits & 0xFF );
+
+    return bytes;
+  }
+
+  static Key decode( const std::string & bytes )
+  {
+    using Unsigned = typename std::make_unsigned<Key>::type;
+
+    Unsigned bits = 0;
+    for( auto byte : bytes )  bits = static_cast<Unsigned>( bits << 8 ) | static_cast<uint8_t>( byte );
+    if( std::is_signed<Key>::value ) bits ^= Unsigned( 1 ) << ( sizeof( Key ) * 8 - 1 );
+
+    return static_cast<Key>( bits );
+  }
+};
+
+
+/*******************************************************************************
+**  Adaptive Radix Tree Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class AdaptiveRadixTree {
+  public:
+    AdaptiveRadixTree             () = default;
+    AdaptiveRadixTree             ( const AdaptiveRadixTree & original );   // performs a deep copy
+    AdaptiveRadixTree & operator= (       AdaptiveRadixTree   rhs      );   // performs a deep copy assignment  NOTE: INTENTIONALLY PASSED BY VALUE (delegates to copy constructor)
+   ~AdaptiveRadixTree             ();
+
+    // Queries
+    Value  search      ( const Key & key )                       const;    // Returns the value associated with key. Throws invalid_argument if key not found
+    void   insert      ( const Key & key, const Value & value );           // Inserts key with value, or replaces the value if key is already present
+    void   remove      ( const Key & key );                                // Removes key if present, otherwise does nothing
+    bool   contains    ( const Key & key )                       const;
+    void   printInorder()                                        const;    // Prints the contents of the tree in ascending byte order
+    size_t size        ()                                        const;
+
+    template <typename Function>                                           // Calls visit( key, value ), in ascending byte order, for every key whose encoding starts
+    void scanPrefix( const Key & prefix, Function visit,                   // with the first byteCount bytes of prefix's encoding.  For std::string keys the default is
+                     size_t byteCount = std::string::npos ) const;         // the whole string;  for integer keys, byteCount selects the high order bytes to match
+
+    void clear();
+
+
+  private:
+    enum NodeType : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+    struct ArtNode {
+      explicit ArtNode( NodeType type ) : type_( type ) {}
+      NodeType type_;
+    };
+
+    struct Leaf : ArtNode {
+      Leaf( const std::string & bytes, const Value & value ) : ArtNode( LEAF ), bytes_( bytes ), value_( value ) {}
+      std::string bytes_;                                                  // the only copy of the key, fully encoded, so a leaf can stand in for a collapsed path
+      Value       value_;
+    };
+
+    struct Inner : ArtNode {
+      explicit Inner( NodeType type ) : ArtNode( type ) {}
+      uint16_t    count_    = 0;                                           // number of children
+      std::string prefix_;                                                 // compressed path:  bytes every key below this node shares
+      Leaf *      terminal_ = nullptr;                                     // the key that ends exactly at this node, if any
+    };
+
+    struct Node4   : Inner { Node4  () : Inner( NODE4   ) {}  uint8_t keys_[4]  = {};  ArtNode * children_[4]   = {}; };
+    struct Node16  : Inner { Node16 () : Inner( NODE16  ) {}  uint8_t keys_[16] = {};  ArtNode * children_[16]  = {}; };
+    struct Node48  : Inner { Node48 () : Inner( NODE48  ) {}  uint8_t slot_[256] = {}; ArtNode * children_[48]  = {}; };  // slot_[byte] is 1 + index into children_, or 0
+    struct Node256 : Inner { Node256() : Inner( NODE256 ) {}                           ArtNode * children_[256] = {}; };
+
+    ArtNode * root_ = nullptr;
+    size_t    size_ = 0;
+
+    // Helper functions
+    Leaf *     searchNode ( const std::string & bytes )                                                     const;
+    void       insert     ( ArtNode * & ref, const std::string & bytes, size_t depth, const Value & value );
+    bool       remove     ( ArtNode * & ref, const std::string & bytes, size_t depth );
+    ArtNode ** findChild  ( Inner * node, uint8_t byte )                                                    const;
+    void       addChild   ( ArtNode * & ref, uint8_t byte, ArtNode * child );
+    void       removeChild( ArtNode * & ref, uint8_t byte );
+    void       collapse   ( ArtNode * & ref );
+    void       clear      ( ArtNode * node );
+
+    template <typename Function>
+    void       visit      ( const ArtNode * node, Function & visitor ) const;                                 // in ascending byte order
+
+    template <typename To>
+    static To * copyHeader( Inner * from );                                                                   // new node of another size with from's prefix and terminal
+
+    static void   removeSorted( uint8_t keys[], ArtNode * children[], uint16_t & count, uint8_t byte );
+    static size_t commonPrefix( const std::string & a, size_t aStart, const std::string & b, size_t bStart );
+};
+
+
+/*******************************************************************************
+**  AdaptiveRadixTree<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value AdaptiveRadixTree<Key, Value>::search( const Key & key ) const
+{
+  auto leaf = searchNode( RadixKeyTraits<Key>::encode( key ) );
+
+  if( leaf == nullptr ) throw std::invalid_argument( "Key not found" );
+  return leaf->value_;
+}
+
+
+
+
+template <typename Key, typename Value>
+bool AdaptiveRadixTree<Key, Value>::contains( const Key & key ) const
+{ return searchNode( RadixKeyTraits<Key>::encode( key ) ) != nullptr; }
+
+
+
+
+template <typename Key, typename Value>
+typename AdaptiveRadixTree<Key, Value>::Leaf * AdaptiveRadixTree<Key, Value>::searchNode( const std::string & bytes ) const
+{
+  auto   node  = root_;
+  size_t depth = 0;
+
+  while( node != nullptr )
+  {
+    if( node->type_ == LEAF )
+    {
+      auto leaf = static_cast<Leaf *>( node );
+      return leaf->bytes_ == bytes ? leaf : nullptr;
+    }
+
+    auto inner = static_cast<Inner *>( node );
+    auto & prefix = inner->prefix_;
+    if( bytes.size() - depth < prefix.size()  ||  bytes.compare( depth, prefix.size(), prefix ) != 0 ) return nullptr;
+
+    depth += prefix.size();
+    if( depth == bytes.size() ) return inner->terminal_;
+
+    auto child = findChild( inner, static_cast<uint8_t>( bytes[depth] ) );
+    if( child == nullptr ) return nullptr;
+
+    node = *child;
+    ++depth;
+  }
+
+  return nullptr;
+}
+
+
+
+
+// Returns the address of the child pointer for byte, or nullptr if there is no such child
+template <typename Key, typename Value>
+typename AdaptiveRadixTree<Key, Value>::ArtNode ** AdaptiveRadixTree<Key, Value>::findChild( Inner * node, uint8_t byte ) const
+{
+  switch( node->type_ )
+  {
+    case NODE4:
+    {
+      auto n = static_cast<Node4 *>( node );
+      for( unsigned i = 0; i < n->count_; ++i )  if( n->keys_[i] == byte ) return &n->children_[i];
+      return nullptr;
+    }
+
+    case NODE16:
+    {
+      auto n = static_cast<Node16 *>( node );
+
+      #if defined(ADAPTIVE_RADIX_TREE_USING_SSE2)
+        auto keys    = _mm_loadu_si128( reinterpret_cast<const __m128i *>( n->keys_ ) );
+        auto matches = _mm_movemask_epi8( _mm_cmpeq_epi8( keys, _mm_set1_epi8( static_cast<char>( byte ) ) ) );
+        matches &= ( 1 << n->count_ ) - 1;                                 // ignore unused key bytes
+        if( matches == 0 ) return nullptr;
+
+        unsigned i = 0;
+        while( ( matches & 1 ) == 0 ) { matches >>= 1;  ++i; }
+        return &n->children_[i];
+
+      #else
+        for( unsigned i = 0; i < n->count_; ++i )  if( n->keys_[i] == byte ) return &n->children_[i];
+        return nullptr;
+
+      #endif
+    }
+
+    case NODE48:
+    {
+      auto n = static_cast<Node48 *>( node );
+      return n->slot_[byte] != 0 ? &n->children_[n->slot_[byte] - 1] : nullptr;
+    }
+
+    case NODE256:
+    {
+      auto n = static_cast<Node256 *>( node );
+      return n->children_[byte] != nullptr ? &n->children_[byte] : nullptr;
+    }
+
+    default:
+      return nullptr;
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::insert( const Key & key, const Value & value )
+{ insert( root_, RadixKeyTraits<Key>::encode( key ), 0, value ); }
+
+
+
+
+// ref is the pointer (root_ or a parent's child slot) that refers to the subtree being inserted into, so a node can be
+// replaced by a larger or split node in place.  depth is the number of key bytes already consumed above this subtree.
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::insert( ArtNode * & ref, const std::string & bytes, size_t depth, const Value & value )
+{
+  if( ref == nullptr )                                                     // Empty subtree
+  {
+    ref = new Leaf( bytes, value );
+    ++size_;
+    return;
+  }
+
+  if( ref->type_ == LEAF )
+  {
+    auto leaf = static_cast<Leaf *>( ref );
+    if( leaf->bytes_ == bytes )                                            // Already present, replace the value
+    {
+      leaf->value_ = value;
+      return;
+    }
+
+    // Two keys now share this position:  replace the leaf with a Node4 holding the bytes they have in common as its prefix
+    auto   node     = new Node4();
+    auto   shared   = commonPrefix( leaf->bytes_, depth, bytes, depth );
+    auto   newDepth = depth + shared;
+    auto   newLeaf  = new Leaf( bytes, value );
+    node->prefix_   = bytes.substr( depth, shared );
+    ref             = node;
+    ++size_;
+
+    if( leaf->bytes_.size() == newDepth ) node->terminal_ = leaf;
+    else                                  addChild( ref, static_cast<uint8_t>( leaf->bytes_[newDepth] ), leaf );
+
+    if( bytes.size() == newDepth )        node->terminal_ = newLeaf;
+    else                                  addChild( ref, static_cast<uint8_t>( bytes[newDepth] ), newLeaf );
+    return;
+  }
+
+  auto inner   = static_cast<Inner *>( ref );
+  auto matched = commonPrefix( inner->prefix_, 0, bytes, depth );
+
+  if( matched < inner->prefix_.size() )                                    // Key leaves the compressed path part way:  split it
+  {
+    auto node     = new Node4();
+    auto newLeaf  = new Leaf( bytes, value );
+    node->prefix_ = inner->prefix_.substr( 0, matched );
+    ref           = node;
+    ++size_;
+
+    auto branchByte = static_cast<uint8_t>( inner->prefix_[matched] );
+    inner->prefix_.erase( 0, matched + 1 );
+    addChild( ref, branchByte, inner );
+
+    if( bytes.size() == depth + matched ) node->terminal_ = newLeaf;
+    else                                  addChild( ref, static_cast<uint8_t>( bytes[depth + matched] ), newLeaf );
+    return;
+  }
+
+  depth += inner->prefix_.size();
+  if( depth == bytes.size() )                                              // Key ends at this node
+  {
+    if( inner->terminal_ != nullptr ) inner->terminal_->value_ = value;
+    else                            { inner->terminal_ = new Leaf( bytes, value );  ++size_; }
+    return;
+  }
+
+  auto byte  = static_cast<uint8_t>( bytes[depth] );
+  auto child = findChild( inner, byte );
+
+  if( child != nullptr ) insert( *child, bytes, depth + 1, value );
+  else                 { addChild( ref, byte, new Leaf( bytes, value ) );  ++size_; }
+}
+
+
+
+
+// Adds child under byte, first growing the node referred to by ref into the next larger size if it is full
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::addChild( ArtNode * & ref, uint8_t byte, ArtNode * child )
+{
+  switch( ref->type_ )
+  {
+    case NODE4:
+    {
+      auto n = static_cast<Node4 *>( ref );
+      if( n->count_ == 4 )
+      {
+        auto bigger = copyHeader<Node16>( n );
+        for( unsigned i = 0; i < 4; ++i ) { bigger->keys_[i] = n->keys_[i];  bigger->children_[i] = n->children_[i]; }
+        bigger->count_ = 4;
+        delete n;
+        ref = bigger;
+        addChild( ref, byte, child );
+        return;
+      }
+
+      unsigned i = n->count_;                                              // keep key bytes sorted for in order traversal
+      for( ; i > 0  &&  n->keys_[i - 1] > byte; --i ) { n->keys_[i] = n->keys_[i - 1];  n->children_[i] = n->children_[i - 1]; }
+      n->keys_[i]     = byte;
+      n->children_[i] = child;
+      ++n->count_;
+      return;
+    }
+
+    case NODE16:
+    {
+      auto n = static_cast<Node16 *>( ref );
+      if( n->count_ == 16 )
+      {
+        auto bigger = copyHeader<Node48>( n );
+        for( unsigned i = 0; i < 16; ++i ) { bigger->slot_[n->keys_[i]] = static_cast<uint8_t>( i + 1 );  bigger->children_[i] = n->children_[i]; }
+        bigger->count_ = 16;
+        delete n;
+        ref = bigger;
+        addChild( ref, byte, child );
+        return;
+      }
+
+      unsigned i = n->count_;
+      for( ; i > 0  &&  n->keys_[i - 1] > byte; --i ) { n->keys_[i] = n->keys_[i - 1];  n->children_[i] = n->children_[i - 1]; }
+      n->keys_[i]     = byte;
+      n->children_[i] = child;
+      ++n->count_;
+      return;
+    }
+
+    case NODE48:
+    {
+      auto n = static_cast<Node48 *>( ref );
+      if( n->count_ == 48 )
+      {
+        auto bigger = copyHeader<Node256>( n );
+        for( unsigned b = 0; b < 256; ++b )  if( n->slot_[b] != 0 ) bigger->children_[b] = n->children_[n->slot_[b] - 1];
+        bigger->count_ = 48;
+        delete n;
+        ref = bigger;
+        addChild( ref, byte, child );
+        return;
+      }
+
+      unsigned i = 0;
+      while( n->children_[i] != nullptr ) ++i;                             // first free slot
+      n->children_[i] = child;
+      n->slot_[byte]  = static_cast<uint8_t>( i + 1 );
+      ++n->count_;
+      return;
+    }
+
+    case NODE256:
+    {
+      auto n = static_cast<Node256 *>( ref );
+      n->children_[byte] = child;
+      ++n->count_;
+      return;
+    }
+
+    default:
+      return;
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+template <typename To>
+To * AdaptiveRadixTree<Key, Value>::copyHeader( Inner * from )
+{
+  auto to       = new To();
+  to->prefix_   = from->prefix_;
+  to->terminal_ = from->terminal_;
+  return to;
+}
+
+
+
+
+// Node4 and Node16 keep their key bytes sorted with children_ in matching positions
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::removeSorted( uint8_t keys[], ArtNode * children[], uint16_t & count, uint8_t byte )
+{
+  unsigned i = 0;
+  while( keys[i] != byte ) ++i;
+
+  std::memmove( keys     + i, keys     + i + 1, ( count - i - 1 ) * sizeof( keys[0]     ) );
+  std::memmove( children + i, children + i + 1, ( count - i - 1 ) * sizeof( children[0] ) );
+  children[--count] = nullptr;
+}
+
+
+
+
+template <typename Key, typename Value>
+size_t AdaptiveRadixTree<Key, Value>::commonPrefix( const std::string & a, size_t aStart, const std::string & b, size_t bStart )
+{
+  size_t length = 0;
+  while( aStart + length < a.size()  &&  bStart + length < b.size()  &&  a[aStart + length] == b[bStart + length] ) ++length;
+  return length;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::remove( const Key & key )
+{
+  if( root_ != nullptr  &&  remove( root_, RadixKeyTraits<Key>::encode( key ), 0 ) ) --size_;
+}
+
+
+
+
+// Returns true if the key was found and removed.  Nodes left with too few children shrink, and a node left with a single
+// child or only a terminal key is collapsed into that child, restoring path compression.
+template <typename Key, typename Value>
+bool AdaptiveRadixTree<Key, Value>::remove( ArtNode * & ref, const std::string & bytes, size_t depth )
+{
+  if( ref->type_ == LEAF )
+  {
+    if( static_cast<Leaf *>( ref )->bytes_ != bytes ) return false;
+
+    delete static_cast<Leaf *>( ref );
+    ref = nullptr;
+    return true;
+  }
+
+  auto inner  = static_cast<Inner *>( ref );
+  auto & prefix = inner->prefix_;
+  if( bytes.size() - depth < prefix.size()  ||  bytes.compare( depth, prefix.size(), prefix ) != 0 ) return false;
+
+  depth += prefix.size();
+  if( depth == bytes.size() )
+  {
+    if( inner->terminal_ == nullptr ) return false;
+
+    delete inner->terminal_;
+    inner->terminal_ = nullptr;
+    collapse( ref );
+    return true;
+  }
+
+  auto byte  = static_cast<uint8_t>( bytes[depth] );
+  auto child = findChild( inner, byte );
+  if( child == nullptr  ||  !remove( *child, bytes, depth + 1 ) ) return false;
+
+  if( *child == nullptr ) removeChild( ref, byte );
+  return true;
+}
+
+
+
+
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::removeChild( ArtNode * & ref, uint8_t byte )
+{
+  switch( ref->type_ )
+  {
+    case NODE4:
+    {
+      auto n = static_cast<Node4 *>( ref );
+      removeSorted( n->keys_, n->children_, n->count_, byte );
+      break;
+    }
+
+    case NODE16:
+    {
+      auto n = static_cast<Node16 *>( ref );
+      removeSorted( n->keys_, n->children_, n->count_, byte );
+
+      if( n->count_ <= 3 )                                                 // shrink to Node4
+      {
+        auto smaller = copyHeader<Node4>( n );
+        for( unsigned i = 0; i < n->count_; ++i ) { smaller->keys_[i] = n->keys_[i];  smaller->children_[i] = n->children_[i]; }
+        smaller->count_ = n->count_;
+        delete n;
+        ref = smaller;
+      }
+      break;
+    }
+
+    case NODE48:
+    {
+      auto n = static_cast<Node48 *>( ref );
+      n->children_[n->slot_[byte] - 1] = nullptr;
+      n->slot_[byte] = 0;
+      --n->count_;
+
+      if( n->count_ <= 12 )                                                // shrink to Node16
+      {
+        auto smaller = copyHeader<Node16>( n );
+        for( unsigned b = 0; b < 256; ++b )
+          if( n->slot_[b] != 0 )
+          {
+            smaller->keys_    [smaller->count_] = static_cast<uint8_t>( b );
+            smaller->children_[smaller->count_] = n->children_[n->slot_[b] - 1];
+            ++smaller->count_;
+          }
+        delete n;
+        ref = smaller;
+      }
+      break;
+    }
+
+    case NODE256:
+    {
+      auto n = static_cast<Node256 *>( ref );
+      n->children_[byte] = nullptr;
+      --n->count_;
+
+      if( n->count_ <= 37 )                                                // shrink to Node48
+      {
+        auto smaller = copyHeader<Node48>( n );
+        for( unsigned b = 0; b < 256; ++b )
+          if( n->children_[b] != nullptr )
+          {
+            smaller->children_[smaller->count_] = n->children_[b];
+            smaller->slot_[b] = static_cast<uint8_t>( ++smaller->count_ );
+          }
+        delete n;
+        ref = smaller;
+      }
+      break;
+    }
+
+    default:
+      return;
+  }
+
+  collapse( ref );
+}
+
+
+
+
+// Replaces an inner node that no longer branches with whatever it still holds
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::collapse( ArtNode * & ref )
+{
+  auto inner = static_cast<Inner *>( ref );
+
+  if( inner->count_ == 0 )                                                 // only a terminal key (or nothing) left
+  {
+    ref = inner->terminal_;
+    inner->terminal_ = nullptr;
+    clear( inner );
+  }
+
+  else if( inner->count_ == 1  &&  inner->terminal_ == nullptr  &&  inner->type_ == NODE4 )
+  {
+    auto n     = static_cast<Node4 *>( inner );
+    auto child = n->children_[0];
+
+    if( child->type_ != LEAF )                                             // merge this node's path into the child's prefix
+    {
+      auto grandchild = static_cast<Inner *>( child );
+      grandchild->prefix_ = n->prefix_ + static_cast<char>( n->keys_[0] ) + grandchild->prefix_;
+    }
+
+    ref = child;
+    n->count_ = 0;
+    clear( n );
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Traversal
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+template <typename Function>
+void AdaptiveRadixTree<Key, Value>::scanPrefix( const Key & prefix, Function visitor, size_t byteCount ) const
+{
+  auto   bytes = std::string( RadixKeyTraits<Key>::encode( prefix ) ).substr( 0, byteCount );
+  auto   node  = root_;
+  size_t depth = 0;
+
+  while( node != nullptr )
+  {
+    if( node->type_ == LEAF )
+    {
+      if( static_cast<Leaf *>( node )->bytes_.compare( 0, bytes.size(), bytes ) == 0 ) visit( node, visitor );
+      return;
+    }
+
+    auto inner     = static_cast<Inner *>( node );
+    auto remaining = bytes.size() - depth;
+    auto compared  = std::min( remaining, inner->prefix_.size() );
+    if( bytes.compare( depth, compared, inner->prefix_, 0, compared ) != 0 ) return;
+
+    if( remaining <= inner->prefix_.size() )                               // prefix exhausted:  everything below matches
+    {
+      visit( node, visitor );
+      return;
+    }
+
+    depth += inner->prefix_.size();
+    auto child = findChild( inner, static_cast<uint8_t>( bytes[depth] ) );
+    if( child == nullptr ) return;
+
+    node = *child;
+    ++depth;
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+template <typename Function>
+void AdaptiveRadixTree<Key, Value>::visit( const ArtNode * node, Function & visitor ) const
+{
+  if( node == nullptr ) return;
+
+  if( node->type_ == LEAF )
+  {
+    auto leaf = static_cast<const Leaf *>( node );
+    visitor( RadixKeyTraits<Key>::decode( leaf->bytes_ ), leaf->value_ );
+    return;
+  }
+
+  auto inner = static_cast<const Inner *>( node );
+  visit( inner->terminal_, visitor );                                      // a key sorts before every key it is a prefix of
+
+  switch( node->type_ )
+  {
+    case NODE4:   { auto n = static_cast<const Node4   *>( node );  for( unsigned i = 0; i < n->count_; ++i ) visit( n->children_[i], visitor );  break; }
+    case NODE16:  { auto n = static_cast<const Node16  *>( node );  for( unsigned i = 0; i < n->count_; ++i ) visit( n->children_[i], visitor );  break; }
+    case NODE48:  { auto n = static_cast<const Node48  *>( node );  for( unsigned b = 0; b < 256; ++b ) if( n->slot_[b] != 0 ) visit( n->children_[n->slot_[b] - 1], visitor );  break; }
+    case NODE256: { auto n = static_cast<const Node256 *>( node );  for( unsigned b = 0; b < 256; ++b ) visit( n->children_[b], visitor );  break; }
+    default:      break;
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::printInorder() const
+{
+  auto print = []( const Key & key, const Value & value ) { std::cout << "Key: \"" << key << "\",  Value: \"" << value << "\"\n"; };
+  visit( root_, print );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+size_t AdaptiveRadixTree<Key, Value>::size() const
+{ return size_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+AdaptiveRadixTree<Key, Value>::AdaptiveRadixTree( const AdaptiveRadixTree & original )
+{
+  auto copy = [this]( const Key & key, const Value & value ) { insert( key, value ); };
+  original.visit( original.root_, copy );
+}
+
+
+
+
+// Passing by value delegates copying the tree to the copy constructor, keeping the "copy" knowledge
+// in one place.  (Copy and swap idiom)
+template <typename Key, typename Value>
+AdaptiveRadixTree<Key, Value> & AdaptiveRadixTree<Key, Value>::operator=( AdaptiveRadixTree rhs )
+{
+  std::swap( root_, rhs.root_ );
+  std::swap( size_, rhs.size_ );
+
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Value>
+AdaptiveRadixTree<Key, Value>::~AdaptiveRadixTree()
+{ clear(); }
+
+
+
+
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::clear()
+{
+  clear( root_ );
+  root_ = nullptr;
+  size_ = 0;
+}
+
+
+
+
+template <typename Key, typename Value>
+void AdaptiveRadixTree<Key, Value>::clear( ArtNode * node )
+{
+  if( node == nullptr ) return;
+
+  switch( node->type_ )
+  {
+    case LEAF:    delete static_cast<Leaf *>( node );  return;
+    case NODE4:   { auto n = static_cast<Node4   *>( node );  for( unsigned i = 0; i < n->count_; ++i ) clear( n->children_[i] );  clear( n->terminal_ );  delete n;  return; }
+    case NODE16:  { auto n = static_cast<Node16  *>( node );  for( unsigned i = 0; i < n->count_; ++i ) clear( n->children_[i] );  clear( n->terminal_ );  delete n;  return; }
+    case NODE48:  { auto n = static_cast<Node48  *>( node );  for( unsigned i = 0; i < 48;        ++i ) clear( n->children_[i] );  clear( n->terminal_ );  delete n;  return; }
+    case NODE256: { auto n = static_cast<Node256 *>( node );  for( unsigned b = 0; b < 256;       ++b ) clear( n->children_[b] );  clear( n->terminal_ );  delete n;  return; }
+  }
+}
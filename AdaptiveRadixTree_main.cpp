@@ -0,0 +1,85 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AdaptiveRadixTree.hpp"
+#include "BinarySearchTree.hpp"
+
+
+
+
+// Times looking up every key (in random order) in each container.  The keys are URLs sharing a long common prefix, the case
+// where BinarySearchTree's operator< re-scans the same leading bytes at every level of the tree.
+template <typename Map>
+void benchmark( const char * name, const std::vector<std::string> & keys, const std::vector<std::string> & probes )
+{
+  using Clock = std::chrono::steady_clock;
+
+  Map map;
+  for( std::size_t i = 0; i < keys.size(); ++i )  map.insert( keys[i], static_cast<double>( i ) );
+
+  double checksum = 0.0;
+  auto   start    = Clock::now();
+  for( const auto & key : probes )  checksum += map.search( key );
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+  std::cout << "  " << name << ":  search " << elapsed.count() / probes.size() << " ns/op  (checksum " << checksum << ")\n";
+}
+
+
+
+
+int main( int argc, char * argv[] ) {
+  AdaptiveRadixTree<std::string, double> studentGrades, gradeBook;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+  studentGrades.insert("Ken", 3.9);                                  // shares the "Ke" path with Kevin
+
+  gradeBook = studentGrades; // test assignment operator, copy constructor, and destructor
+
+  std::string myKey = "Ellen"; // find grade of one student
+  std::cout << "Grade of " << myKey << " is " << studentGrades.search(myKey) << '\n';
+
+  studentGrades.printInorder(); // print the entire tree in sorted order
+
+  std::cout << "Students starting with \"K\":\n";
+  studentGrades.scanPrefix( "K", []( const std::string & key, double value ) { std::cout << "  " << key << ' ' << value << '\n'; } );
+
+  gradeBook.remove( "Ellen" );
+  if( gradeBook.contains( "Ellen" ) || gradeBook.size() != 5 ) std::cerr << "Remove did not match expected\n";
+
+
+  AdaptiveRadixTree<int, std::string> roomNumbers;                   // integer keys are stored big-endian, so byte order is numeric order
+  roomNumbers.insert( 131, "CS-104" );
+  roomNumbers.insert( -1,  "Basement" );
+  roomNumbers.insert( 256, "CS-110" );
+  roomNumbers.printInorder();                                        // -1, 131, 256
+
+
+
+  // Usage:  AdaptiveRadixTree [entries]
+  std::size_t count = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  std::mt19937_64 generator( 131 );
+
+  std::vector<std::string> keys;
+  keys.reserve( count );
+  for( std::size_t i = 0; i < count; ++i )  keys.push_back( "https://www.fullerton.edu/ecs/cs/courses/cpsc-131/sections/" + std::to_string( generator() ) );
+
+  auto probes = keys;
+  std::shuffle( probes.begin(), probes.end(), generator );
+
+  std::cout << count << " URL keys\n";
+  benchmark<BinarySearchTree <std::string, double>>( "BinarySearchTree ", keys, probes );
+  benchmark<AdaptiveRadixTree<std::string, double>>( "AdaptiveRadixTree", keys, probes );
+}
+
+
+
+template class AdaptiveRadixTree<unsigned, float>;
@@ -0,0 +1,145 @@
+#pragma once
+#include <limits>     // numeric_limits
+#include <algorithm>  // min(), max()
+
+#include "BinarySearchTree.hpp"
+
+// A BinarySearchTree whose nodes also cache an aggregate of every value in their subtree, kept current by the tree's own insert,
+// remove, bulk updates, and scapegoat rebuilds through its Augment policy.  Any range of keys is the union of O(height) whole
+// subtrees plus the nodes on two root-to-leaf paths, so aggregate( lo, hi ) combines O(height) cached aggregates instead of
+// visiting every node in the range.
+//
+// The aggregate is described by a Monoid policy:  an associative combine() with an identity() element, and lift() to turn one
+// value into an aggregate.  combine() need not be commutative;  operands are always combined in ascending key order.
+// SumMonoid, MinMonoid, and MaxMonoid are provided;  any struct with the same static members can be supplied instead:
+//
+//     struct Monoid {
+//       using Result = ...;
+//       static Result identity();
+//       static Result lift   ( const Value  & value );
+//       static Result combine( const Result & left, const Result & right );
+//     };
+
+
+/*******************************************************************************
+**  Provided Monoids
+*******************************************************************************/
+template <typename Value>
+struct SumMonoid {
+  using Result = Value;
+  static Result identity()                                         { return Value(); }
+  static Result lift   ( const Value  & value )                     { return value; }
+  static Result combine( const Result & left, const Result & right ) { return left + right; }
+};
+
+template <typename Value>
+struct MinMonoid {
+  using Result = Value;
+  static Result identity()                                         { return std::numeric_limits<Value>::max(); }
+  static Result lift   ( const Value  & value )                     { return value; }
+  static Result combine( const Result & left, const Result & right ) { return std::min( left, right ); }
+};
+
+template <typename Value>
+struct MaxMonoid {
+  using Result = Value;
+  static Result identity()                                         { return std::numeric_limits<Value>::lowest(); }
+  static Result lift   ( const Value  & value )                     { return value; }
+  static Result combine( const Result & left, const Result & right ) { return std::max( left, right ); }
+};
+
+
+/*******************************************************************************
+**  Monoid Augmentation Policy
+*******************************************************************************/
+template <typename Monoid>
+struct MonoidAugment {
+  using Result = typename Monoid::Result;
+
+  struct Fields {
+    Result aggregate_ = Monoid::identity();                                // Monoid aggregate of every value in this node's subtree
+  };
+
+  template <typename NodeType>
+  static Result aggregateOf( const NodeType * node )                       // identity() for an empty subtree
+  { return node == nullptr ? Monoid::identity() : node->aggregate_; }
+
+  template <typename NodeType>
+  static void refresh( NodeType * node )
+  { node->aggregate_ = Monoid::combine( Monoid::combine( aggregateOf( node->left_ ), Monoid::lift( node->value_ ) ), aggregateOf( node->right_ ) ); }
+};
+
+
+/*******************************************************************************
+**  Augmented Binary Search Tree Abstract Data Type Definition (Duplicate keys allowed)
+*******************************************************************************/
+template <typename Key, typename Value, typename Monoid = SumMonoid<Value>>
+class AugmentedBinarySearchTree : public BinarySearchTree<Key, Value, MonoidAugment<Monoid>> {
+  public:
+    using Result = typename Monoid::Result;
+
+    // Queries
+    Result aggregate( const Key & lo, const Key & hi )           const;    // Aggregate of the values of every key in [lo, hi], in O(height)
+    Result aggregate()                                           const;    // Aggregate of every value in the tree, in O(1)
+
+
+  protected:                                                               // specializations such as IntervalTree walk the nodes directly
+    using NodeType = Node<Key, Value, MonoidAugment<Monoid>>;
+};
+
+
+/*******************************************************************************
+**  AugmentedBinarySearchTree<Key, Value, Monoid>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Aggregates
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Monoid>
+typename Monoid::Result AugmentedBinarySearchTree<Key, Value, Monoid>::aggregate() const
+{ return MonoidAugment<Monoid>::aggregateOf( this->root_ ); }
+
+
+
+
+// Descend to the split node, the highest node inside [lo, hi].  Below it, the path toward lo passes nodes whose right
+// subtrees lie entirely inside the range, and the path toward hi passes nodes whose left subtrees do, so their cached
+// aggregates are used whole.
+template <typename Key, typename Value, typename Monoid>
+typename Monoid::Result AugmentedBinarySearchTree<Key, Value, Monoid>::aggregate( const Key & lo, const Key & hi ) const
+{
+  auto aggregateOf = []( const NodeType * node ) { return MonoidAugment<Monoid>::aggregateOf( node ); };
+
+  auto split = this->root_;
+  while( split != nullptr )
+  {
+    if     ( split->key_ < lo )  split = split->right_;
+    else if( hi < split->key_ )  split = split->left_;
+    else                         break;
+  }
+  if( split == nullptr ) return Monoid::identity();
+
+  auto leftPart = Monoid::identity();                                      // keys in [lo, split)
+  for( auto cur = split->left_; cur != nullptr; )
+  {
+    if( cur->key_ < lo )  cur = cur->right_;
+    else
+    {
+      leftPart = Monoid::combine( Monoid::combine( Monoid::lift( cur->value_ ), aggregateOf( cur->right_ ) ), leftPart );
+      cur      = cur->left_;
+    }
+  }
+
+  auto rightPart = Monoid::identity();                                     // keys in (split, hi]
+  for( auto cur = split->right_; cur != nullptr; )
+  {
+    if( hi < cur->key_ )  cur = cur->left_;
+    else
+    {
+      rightPart = Monoid::combine( rightPart, Monoid::combine( aggregateOf( cur->left_ ), Monoid::lift( cur->value_ ) ) );
+      cur       = cur->right_;
+    }
+  }
+
+  return Monoid::combine( Monoid::combine( leftPart, Monoid::lift( split->value_ ) ), rightPart );
+}
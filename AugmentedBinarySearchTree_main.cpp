@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+
+#include "AugmentedBinarySearchTree.hpp"
+
+
+
+
+// A user-supplied aggregate:  count and total together give the mean of any key range
+struct Mean {
+  unsigned count = 0;
+  double   total = 0.0;
+};
+
+struct MeanMonoid {
+  using Result = Mean;
+  static Result identity()                                         { return Mean(); }
+  static Result lift   ( double value )                             { return Mean{ 1, value }; }
+  static Result combine( const Result & left, const Result & right ) { return Mean{ left.count + right.count, left.total + right.total }; }
+};
+
+
+
+
+int main() {
+  // Requests served per minute, keyed by minute of the day
+  AugmentedBinarySearchTree<unsigned, double>                       totals;
+  AugmentedBinarySearchTree<unsigned, double, MaxMonoid<double>>    peaks;
+  AugmentedBinarySearchTree<unsigned, double, MeanMonoid>           means;
+
+  unsigned minutes [] = { 600, 540, 660, 510, 570, 630, 690 };
+  double   requests[] = {  40,  25,  55,  10,  35,  70,  20 };
+
+  for( unsigned i = 0; i < 7; ++i )
+  {
+    totals.insert( minutes[i], requests[i] );
+    peaks .insert( minutes[i], requests[i] );
+    means .insert( minutes[i], requests[i] );
+  }
+
+  std::cout << "Requests 9:00 to 10:30:  " << totals.aggregate( 540, 630 ) << '\n';    // 25 + 35 + 40 + 70 = 170
+  std::cout << "Peak     9:00 to 10:30:  " << peaks .aggregate( 540, 630 ) << '\n';    // 70
+  auto mean = means.aggregate( 540, 630 );
+  std::cout << "Mean     9:00 to 10:30:  " << mean.total / mean.count << '\n';         // 42.5
+  std::cout << "Requests all day:        " << totals.aggregate() << '\n';             // 255
+
+  if( totals.aggregate( 541, 569 ) != 0.0 ) std::cerr << "Empty range did not match expected\n";
+
+  totals.remove( 630 );
+  if( totals.aggregate( 540, 630 ) != 100.0 ) std::cerr << "Aggregate after remove does not match expected\n";
+
+  auto copy = totals; // test copy constructor
+  copy.insert( 545, 5.0 );
+  if( copy.aggregate() != 190.0 || totals.aggregate() != 185.0 ) std::cerr << "Copy is not independent of the original\n";
+
+  copy.eraseRange( 540, 600 );                                                         // the inherited bulk updates keep aggregates current too
+  if( copy.aggregate() != 85.0 || copy.aggregate( 500, 600 ) != 10.0 ) std::cerr << "Aggregate after eraseRange does not match expected\n";
+}
+
+
+
+template class AugmentedBinarySearchTree<unsigned, float>;
+template class AugmentedBinarySearchTree<int, long, MinMonoid<long>>;
+template class BinarySearchTree<unsigned, float, MonoidAugment<SumMonoid<float>>>;
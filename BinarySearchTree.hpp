@@ -1,7 +1,13 @@
 #pragma once
 #include <iostream>
 #include <stdexcept>
-#include <algorithm>  // max(), swap()
+#include <algorithm>  // max(), swap(), stable_sort(), inplace_merge(), merge()
+#include <cmath>      // log()
+#include <cstddef>    // size_t
+#include <thread>
+#include <type_traits> // is_same
+#include <utility>    // pair
+#include <vector>
 
 // This source file has both iterative and recursive implementations for some functions so the two can be studied and compared side
 // by side.  To select which version to use (compile and runtime), define either USING_ITERATIVE_FUNCTIONS or
@@ -16,11 +22,25 @@
 #endif
 
 
+/*******************************************************************************
+**  Node Augmentation Policy
+*******************************************************************************/
+// Nodes can cache extra data summarizing their subtree, such as AugmentedBinarySearchTree's aggregates.  An Augment policy
+// supplies that data as a Fields struct every node inherits from, and a static refresh( node ) that recomputes it from the
+// node's own key and value and its children's Fields.  The tree calls refresh() bottom up on every node whose subtree changed,
+// after each insert, remove, and rebuild.  NoAugment, the default, has empty Fields (so the node layout is unchanged) and the
+// tree skips the refresh walks entirely.
+struct NoAugment {
+  struct Fields {};
+  template <typename NodeType> static void refresh( NodeType * ) {}
+};
+
+
 /*******************************************************************************
 **  Binary Search Tree Node Definition
 *******************************************************************************/
-template <typename Key, typename Value>
-struct Node {
+template <typename Key, typename Value, typename Augment = NoAugment>
+struct Node : Augment::Fields {
   // Constructors
   Node( const Key & key = Key(),  const Value & value = Value() );   // Also serves as the default constructor
 
@@ -34,14 +54,14 @@ struct Node {
   Node * parent_ = nullptr;
 };
 
-template <typename Key, typename Value>
-std::ostream & operator<<( std::ostream & stream, const Node<Key, Value> & node );
+template <typename Key, typename Value, typename Augment>
+std::ostream & operator<<( std::ostream & stream, const Node<Key, Value, Augment> & node );
 
 
 /*******************************************************************************
 **  Binary Search Tree Abstract Data Type Definition (Duplicate keys allowed)
 *******************************************************************************/
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Augment = NoAugment>
 class BinarySearchTree {
   public:
     BinarySearchTree             () = default;
@@ -51,47 +71,123 @@ class BinarySearchTree {
 
     // Queries
     Value search     ( const Key & key )                       const;       // zyBook 7.4, 7.10:  Returns the value associated with the first node found matching given key. Throws invalid_argument if key not found
+    bool  contains   ( const Key & key )                       const;       // Returns true if a node matching given key exists
+    const Value * find( const Key & key )                      const;       // Returns the value of the first node found matching given key, or nullptr if key not found:  search() and contains() in one walk
     void insert      ( const Key & key, const Value & value );              // zyBook 7.5, 7.9, 7.10:  Inserts a new node populated with key and value in a proper location obeying the BST ordering property.
     void remove      ( const Key & key );                                   // zyBook 7.6, 7.9, 7.10:  Removes the first-found matching node, restructuring the tree to preserve the BST ordering property.
     void printInorder()                                        const;       // zyBook 7.7:  Prints the contents of the tree in ascending sorted order
     int  getHeight   ()                                        const;       // zyBook 7.8:  Returns the height of the tree, or -1 if tree is empty
 
+    // Bulk updates
+    template <typename Iterator>
+    void        insertBatch( Iterator first, Iterator last );               // Inserts every ( key, value ) pair in [first, last), in any order, as if by insert().  Large batches sort and rebuild in parallel (compile with -pthread)
+    std::size_t eraseRange ( const Key & lo, const Key & hi );              // Removes every node with lo <= key <= hi in one pass.  Returns the number removed
+    template <typename Predicate>
+    std::size_t eraseIf    ( Predicate predicate );                         // Removes every node for which predicate( key, value ) is true in one pass.  Returns the number removed
+
+    template <typename Function>
+    void visitInorder( Function visit )                        const;       // Calls visit( key, value ) for every node in ascending key order
+
+    class Cursor;
+    Cursor cursor()                                            const;       // A cursor at the smallest key, or past the end if the tree is empty
+
     void clear();                                                           // Returns the tree to an empty state releasing all nodes
 
+    std::size_t size()                                         const;       // Returns the number of nodes in the tree
 
-  private:
-    Node<Key, Value> * root_ = nullptr;
+    // Scapegoat mode:  with 0.5 < alpha < 1, an insert landing deeper than log base 1/alpha of size() rebuilds the subtree that
+    // became too lopsided (the "scapegoat") into perfect balance, and removes rebuild the whole tree once size() falls below alpha
+    // times its high-water mark.  Lower alpha keeps the tree shorter at the cost of more rebuilding.  0 (the default) turns it off.
+    void setScapegoatAlpha( double alpha );                                 // Throws invalid_argument unless alpha is 0 or within (0.5, 1)
+
+
+  protected:                                                                // extensions such as AugmentedBinarySearchTree walk the nodes directly
+    Node<Key, Value, Augment> * root_    = nullptr;
+    std::size_t                 size_    = 0;
+    std::size_t                 maxSize_ = 0;                               // largest size_ since the last full rebuild (scapegoat mode)
+    double                      alpha_   = 0.0;                             // 0 when scapegoat mode is off
 
     // Helper functions
-    void clear          ( Node<Key, Value> * node );
-    void insertIterative( Node<Key, Value> * node );                                         // zyBook Figure 7.9.1: BSTInsert algorithm for BSTs with nodes containing parent pointers.
-    void insertRecursive( Node<Key, Value> * parent, Node<Key, Value> * nodeToInsert );      // zyBook Figure 7.10.2: Recursive BST insertion and removal.
-    void remove         ( Node<Key, Value> * node );                                         // zyBook Figure 7.9.3: BSTRemoveKey and BSTRemoveNode algorithms for BSTs with nodes containing parent pointers.  (Figure 7.10.2 identical but passes parent instead of using parent pointer in Node)
-    void printInorder   ( Node<Key, Value> * node ) const;                                   // zyBook Figure 7.7.1: BST inorder traversal algorithm.
-    int  getHeight      ( Node<Key, Value> * node ) const;                                   // zyBook Figure 7.8.3: BSTGetHeight algorithm.
+    void clear          ( Node<Key, Value, Augment> * node );
+    void insertIterative( Node<Key, Value, Augment> * node );                                             // zyBook Figure 7.9.1: BSTInsert algorithm for BSTs with nodes containing parent pointers.
+    void insertRecursive( Node<Key, Value, Augment> * parent, Node<Key, Value, Augment> * nodeToInsert ); // zyBook Figure 7.10.2: Recursive BST insertion and removal.
+    void remove         ( Node<Key, Value, Augment> * node );                                             // zyBook Figure 7.9.3: BSTRemoveKey and BSTRemoveNode algorithms for BSTs with nodes containing parent pointers.  (Figure 7.10.2 identical but passes parent instead of using parent pointer in Node)
+    void printInorder   ( Node<Key, Value, Augment> * node ) const;                                       // zyBook Figure 7.7.1: BST inorder traversal algorithm.
+    int  getHeight      ( Node<Key, Value, Augment> * node ) const;                                       // zyBook Figure 7.8.3: BSTGetHeight algorithm.
+
+    template <typename Function>
+    void visitInorder   ( Node<Key, Value, Augment> * node, Function & visit ) const;                     // zyBook Figure 7.7.1: BST inorder traversal algorithm.
+
+
+    Node<Key, Value, Augment> * makeCopy       ( Node<Key, Value, Augment> * node );                      // Copy constructor helper function
+
+    Node<Key, Value, Augment> * searchIterative(                                   const Key & key ) const;   // zyBook Figure 7.4.1: BST search algorithm.
+    Node<Key, Value, Augment> * searchRecursive( Node<Key, Value, Augment> * node, const Key & key ) const;   // zyBook Figure 7.10.1: BST recursive search algorithm.
+
+    bool replaceChild( Node<Key, Value, Augment> * parent,                                                // zyBook Figure 7.9.2: BSTReplaceChild algorithm.
+                       Node<Key, Value, Augment> * currentChild,
+                       Node<Key, Value, Augment> * newChild );
+
+    static void refreshToRoot( Node<Key, Value, Augment> * node );                                        // Augment::refresh() for node and each of its ancestors, bottom up
+
+    static Node<Key, Value, Augment> * eraseRange( Node<Key, Value, Augment> * node, const Key & lo, const Key & hi, std::size_t & erased );   // Returns what is left of node's subtree
+    static Node<Key, Value, Augment> * join      ( Node<Key, Value, Augment> * left, Node<Key, Value, Augment> * right );                      // Joins two subtrees, every key in left before every key in right
+    void                               removed   ( std::size_t erased );                                  // Bookkeeping after removing erased nodes
+
+    void                               rebalanceFrom( Node<Key, Value, Augment> * node );                 // Scapegoat mode:  rebuilds an ancestor of a too-deep node
+    void                               rebuild      ( Node<Key, Value, Augment> * node );                 // Rebuilds node's subtree into perfect balance, reusing its nodes
+    static Node<Key, Value, Augment> * buildBalanced( Node<Key, Value, Augment> * & list, std::size_t count );                    // Builds from the first count nodes of a right-linked sorted list
+    static Node<Key, Value, Augment> * buildBalanced( Node<Key, Value, Augment> ** nodes, std::size_t count, unsigned threads );  // Builds from a sorted array, splitting the work over threads
+    static Node<Key, Value, Augment> * flatten      ( Node<Key, Value, Augment> * node, std::size_t & count );                    // Relinks node's subtree into a right-linked sorted list, returning its head
+    static std::size_t                 countNodes   ( Node<Key, Value, Augment> * node );
+    static Node<Key, Value, Augment> * successor    ( Node<Key, Value, Augment> * node );                 // Next node in order, or nullptr
+    static Node<Key, Value, Augment> * predecessor  ( Node<Key, Value, Augment> * node );                 // Previous node in order, or nullptr
+
+    template <typename Function>
+    static void                        runInParallel( unsigned tasks, Function task );                    // Runs task( 0 ) ... task( tasks - 1 ) concurrently, each on its own thread
+
+};
+
 
+/*******************************************************************************
+**  Cursor Definition
+*******************************************************************************/
+// A position in the tree's in-order sequence, or just past its end.  Stepping with next() and prev() costs O(1) amortized,
+// and seek() searches from where the cursor already is:  it climbs only until it reaches a subtree that must hold the key,
+// then descends.  That costs the cursor node's depth below the lowest common ancestor of the two keys plus the descent from
+// it, which is not bounded by the distance d between the keys:  two adjacent keys on either side of the root still cost a
+// full climb and descent.  Only amortized over a monotone sweep through a balanced tree is it O(log d) per seek.
+// Inserts leave cursors valid (no node moves, even when scapegoat mode rebuilds);  any removal may invalidate them.
+template <typename Key, typename Value, typename Augment>
+class BinarySearchTree<Key, Value, Augment>::Cursor {
+  public:
+    bool          valid()                   const { return node_ != nullptr; }
+    const Key &   key  ()                   const;                          // Throws out_of_range if past the end
+    const Value & value()                   const;                          // Throws out_of_range if past the end
 
-    Node<Key, Value> * makeCopy       ( Node<Key, Value> * node );                           // Copy constructor helper function
+    bool          seek ( const Key & key );                                 // Moves to the first node whose key is not less than key.  Returns true if it matches
+    Cursor &      next ();                                                  // Moves to the next node, or past the end
+    Cursor &      prev ();                                                  // Moves to the previous node (from past the end, to the last node);  stays at the first node
 
-    Node<Key, Value> * searchIterative(                          const Key & key ) const;    // zyBook Figure 7.4.1: BST search algorithm.
-    Node<Key, Value> * searchRecursive( Node<Key, Value> * node, const Key & key ) const;    // zyBook Figure 7.10.1: BST recursive search algorithm.
 
-    bool replaceChild( Node<Key, Value> * parent,                                            // zyBook Figure 7.9.2: BSTReplaceChild algorithm.
-                       Node<Key, Value> * currentChild,
-                       Node<Key, Value> * newChild );
+  private:
+    friend class BinarySearchTree;
+    Cursor( const BinarySearchTree * tree, Node<Key, Value, Augment> * node ) : tree_( tree ), node_( node ) {}
 
+    const BinarySearchTree *    tree_;
+    Node<Key, Value, Augment> * node_;                                      // nullptr when past the end
 };
 
 
 /*******************************************************************************
-**  BinarySearchTree<Key, Value>  Definitions
+**  BinarySearchTree<Key, Value, Augment>  Definitions
 *******************************************************************************/
 
 ////////////////////////////////////////////////////////////////////////////////
 //  Search
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Key, typename Value>
-Value BinarySearchTree<Key, Value>::search( const Key  & key ) const
+template <typename Key, typename Value, typename Augment>
+Value BinarySearchTree<Key, Value, Augment>::search( const Key  & key ) const
 {
   #if defined(USING_ITERATIVE_FUNCTIONS)
     auto node = searchIterative( key );                 // zyBook 7.4.1: BST search algorithm.
@@ -108,9 +204,41 @@ Value BinarySearchTree<Key, Value>::search( const Key  & key ) const
 
 
 
+template <typename Key, typename Value, typename Augment>
+bool BinarySearchTree<Key, Value, Augment>::contains( const Key & key ) const
+{
+  #if defined(USING_ITERATIVE_FUNCTIONS)
+    return searchIterative( key ) != nullptr;
+
+  #elif defined(USING_RECURSIVE_FUNCTIONS)
+    return searchRecursive( root_, key ) != nullptr;
+
+  #endif
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+const Value * BinarySearchTree<Key, Value, Augment>::find( const Key & key ) const
+{
+  #if defined(USING_ITERATIVE_FUNCTIONS)
+    auto node = searchIterative( key );
+
+  #elif defined(USING_RECURSIVE_FUNCTIONS)
+    auto node = searchRecursive( root_, key );
+
+  #endif
+
+  return node == nullptr ? nullptr : &node->value_;
+}
+
+
+
+
 //  zyBook 7.4.1: BST search algorithm.
-template <typename Key, typename Value>
-Node<Key, Value> * BinarySearchTree<Key, Value>::searchIterative( const Key  & key ) const
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::searchIterative( const Key  & key ) const
 {
   auto cur = root_;
 
@@ -128,8 +256,8 @@ Node<Key, Value> * BinarySearchTree<Key, Value>::searchIterative( const Key  & k
 
 
 //  zyBook 7.10.1: BST recursive search algorithm.
-template <typename Key, typename Value>
-Node<Key, Value> * BinarySearchTree<Key, Value>::searchRecursive( Node<Key, Value> * node, const Key & key ) const
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::searchRecursive( Node<Key, Value, Augment> * node, const Key & key ) const
 {
   if( node != nullptr )
   {
@@ -147,10 +275,10 @@ Node<Key, Value> * BinarySearchTree<Key, Value>::searchRecursive( Node<Key, Valu
 ////////////////////////////////////////////////////////////////////////////////
 //  Insert
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::insert( const Key & key, const Value & value )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::insert( const Key & key, const Value & value )
 {
-  auto node = new Node<Key, Value>( key, value );
+  auto node = new Node<Key, Value, Augment>( key, value );
 
   #if defined(USING_ITERATIVE_FUNCTIONS)
     insertIterative(        node );                          // Figure 7.9.1: BSTInsert algorithm for BSTs with nodes containing parent pointers.
@@ -160,14 +288,88 @@ void BinarySearchTree<Key, Value>::insert( const Key & key, const Value & value
     else                   insertRecursive( root_, node );   // Figure 7.10.2: Recursive BST insertion and removal.
 
   #endif
+
+  refreshToRoot( node );
+  ++size_;
+  maxSize_ = std::max( maxSize_, size_ );
+  if( alpha_ > 0.0 ) rebalanceFrom( node );
+}
+
+
+
+
+// Inserting m keys one at a time chases O(log n) pointers per key.  A large batch is instead sorted, in parallel chunks merged
+// pairwise, then merged with the tree's own nodes (flattened in order) and the whole tree rebuilt in perfect balance, with
+// node allocation and the rebuild split across threads too:  the cost is dominated by the sort, O(m log m / threads), plus
+// O(n + m) to merge.  Sorting is stable and existing nodes come first among equal keys, so duplicate keys end up in the
+// same order repeated insert() calls would give them.  Small batches, or batches small next to the tree, are not worth
+// rebuilding the whole tree for and are inserted one at a time.
+template <typename Key, typename Value, typename Augment>
+template <typename Iterator>
+void BinarySearchTree<Key, Value, Augment>::insertBatch( Iterator first, Iterator last )
+{
+  constexpr std::size_t MIN_BATCH = 4096;                             // below this, plain inserts win
+  constexpr std::size_t MIN_CHUNK = 16384;                            // smallest share of the sort worth a thread
+
+  std::vector<std::pair<Key, Value>> entries;
+  for( ; first != last; ++first )  entries.emplace_back( first->first, first->second );
+
+  auto count = entries.size();
+  if( count < MIN_BATCH  ||  count * 16 < size_ )
+  {
+    for( const auto & entry : entries )  insert( entry.first, entry.second );
+    return;
+  }
+
+  unsigned threads = std::max( 1u, std::thread::hardware_concurrency() );
+  threads          = static_cast<unsigned>( std::max<std::size_t>( 1, std::min<std::size_t>( threads, count / MIN_CHUNK ) ) );
+
+  std::vector<std::size_t> bounds( threads + 1 );                     // chunk i is [bounds[i], bounds[i + 1])
+  for( unsigned i = 0; i <= threads; ++i )  bounds[i] = count * i / threads;
+
+  auto byKey = []( const auto & lhs, const auto & rhs ) { return lhs.first < rhs.first; };
+  auto begin = entries.begin();
+
+  runInParallel( threads, [&]( unsigned i ) { std::stable_sort( begin + bounds[i], begin + bounds[i + 1], byKey ); } );
+
+  for( unsigned width = 1; width < threads; width *= 2 )              // merge neighbouring sorted runs, doubling their width
+  {
+    auto pairs = ( threads + 2 * width - 1 ) / ( 2 * width );
+    runInParallel( pairs, [&]( unsigned i ) {
+      auto low = 2 * width * i;
+      if( low + width >= threads ) return;                            // odd run out, nothing to merge with this round
+      std::inplace_merge( begin + bounds[low], begin + bounds[low + width], begin + bounds[std::min( low + 2 * width, threads )], byKey );
+    } );
+  }
+
+  std::vector<Node<Key, Value, Augment> *> added( count );
+  runInParallel( threads, [&]( unsigned i ) {
+    for( auto j = bounds[i]; j < bounds[i + 1]; ++j )  added[j] = new Node<Key, Value, Augment>( entries[j].first, entries[j].second );
+  } );
+  entries = {};                                                       // release the copies before the tree grows
+
+  std::vector<Node<Key, Value, Augment> *> existing;
+  existing.reserve( size_ );
+
+  std::size_t existingCount = 0;
+  for( auto node = root_ != nullptr ? flatten( root_, existingCount ) : nullptr; node != nullptr; node = node->right_ )  existing.push_back( node );
+
+  std::vector<Node<Key, Value, Augment> *> nodes( existing.size() + added.size() );
+  std::merge( existing.begin(), existing.end(), added.begin(), added.end(), nodes.begin(),
+              []( const Node<Key, Value, Augment> * lhs, const Node<Key, Value, Augment> * rhs ) { return lhs->key_ < rhs->key_; } );
+
+  root_          = buildBalanced( nodes.data(), nodes.size(), threads );
+  root_->parent_ = nullptr;
+  size_          = nodes.size();
+  maxSize_       = size_;                                             // the tree was just rebuilt in full
 }
 
 
 
 
 //  Figure 7.9.1: BSTInsert algorithm for BSTs with nodes containing parent pointers.
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::insertIterative( Node<Key, Value> * node )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::insertIterative( Node<Key, Value, Augment> * node )
 {
   node->left_  = nullptr;                                         // insert as a leaf (added to zyBook algorithm for completeness)
   node->right_ = nullptr;
@@ -217,8 +419,8 @@ void BinarySearchTree<Key, Value>::insertIterative( Node<Key, Value> * node )
 
 
 //  zyBook Figure 7.10.2: Recursive BST insertion and removal.  (Assumes parent and nodeToInsert are not null)
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::insertRecursive( Node<Key, Value> * parent, Node<Key, Value> * nodeToInsert )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::insertRecursive( Node<Key, Value, Augment> * parent, Node<Key, Value, Augment> * nodeToInsert )
 {
   if( nodeToInsert->key_ < parent->key_ )
   {
@@ -247,8 +449,8 @@ void BinarySearchTree<Key, Value>::insertRecursive( Node<Key, Value> * parent, N
 //  Remove
 ////////////////////////////////////////////////////////////////////////////////
 //  zyBook Figure 7.9.3: BSTRemoveKey and BSTRemoveNode algorithms for BSTs with nodes containing parent pointers.
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::remove( const Key & key )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::remove( const Key & key )
 {
   #if defined(USING_ITERATIVE_FUNCTIONS)
     auto node = searchIterative( key );
@@ -258,15 +460,33 @@ void BinarySearchTree<Key, Value>::remove( const Key & key )
 
   #endif
 
+  if( node == nullptr ) return;
+
   remove( node );
+  removed( 1 );
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::removed( std::size_t erased )
+{
+  size_ -= erased;
+
+  if( alpha_ > 0.0  &&  size_ < alpha_ * maxSize_ )                   // Scapegoat mode:  too many removes since the last full rebuild
+  {
+    if( root_ != nullptr ) rebuild( root_ );
+    maxSize_ = size_;
+  }
 }
 
 
 
 
 //  zyBook Figure 7.9.3: BSTRemoveKey and BSTRemoveNode algorithms for BSTs with nodes containing parent pointers.
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::remove( Node<Key, Value> * node )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::remove( Node<Key, Value, Augment> * node )
 {
   if( node == nullptr ) return;
 
@@ -288,6 +508,8 @@ void BinarySearchTree<Key, Value>::remove( Node<Key, Value> * node )
 
   else
   {
+    auto parent = node->parent_;
+
     // Case 2: Root node (with 1 or 0 children)
     if (node == root_)
     {
@@ -307,6 +529,7 @@ void BinarySearchTree<Key, Value>::remove( Node<Key, Value> * node )
     else                                replaceChild( node->parent_, node, node->right_ );
 
     delete node;  // Not in zyBook algorithm, but needed to prevent memory leak
+    refreshToRoot( parent );
   }
 }
 
@@ -314,10 +537,10 @@ void BinarySearchTree<Key, Value>::remove( Node<Key, Value> * node )
 
 
 //  zyBook Figure 7.9.2: BSTReplaceChild algorithm.
-template <typename Key, typename Value>
-bool BinarySearchTree<Key, Value>::replaceChild( Node<Key, Value> * parent,
-                                                 Node<Key, Value> * currentChild,
-                                                 Node<Key, Value> * newChild )
+template <typename Key, typename Value, typename Augment>
+bool BinarySearchTree<Key, Value, Augment>::replaceChild( Node<Key, Value, Augment> * parent,
+                                                 Node<Key, Value, Augment> * currentChild,
+                                                 Node<Key, Value, Augment> * newChild )
 {
   if( parent->left_ != currentChild  &&  parent->right_ != currentChild )   return false;
 
@@ -332,11 +555,153 @@ bool BinarySearchTree<Key, Value>::replaceChild( Node<Key, Value> * parent,
 
 
 
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::refreshToRoot( Node<Key, Value, Augment> * node )
+{
+  if( std::is_same<Augment, NoAugment>::value ) return;               // nothing cached, so no need to walk the path
+
+  for( ; node != nullptr; node = node->parent_ )  Augment::refresh( node );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Bulk removal
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Augment>
+std::size_t BinarySearchTree<Key, Value, Augment>::eraseRange( const Key & lo, const Key & hi )
+{
+  if( hi < lo ) return 0;
+
+  std::size_t erased = 0;
+  root_ = eraseRange( root_, lo, hi, erased );
+  if( root_ != nullptr ) root_->parent_ = nullptr;
+
+  removed( erased );
+  return erased;
+}
+
+
+
+
+// Subtrees entirely outside the range are never entered:  the walk only follows the two paths down to lo and hi, and visits
+// every node between them once to delete it, O(k + height) in all.  A deleted node's surviving left side holds only keys below
+// lo and its right side only keys above hi, so at most one node (the highest in the range) has survivors on both sides to
+// join.  No survivor ends up deeper than it was, so like remove() an erase never makes the tree taller.
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::eraseRange( Node<Key, Value, Augment> * node, const Key & lo, const Key & hi, std::size_t & erased )
+{
+  if( node == nullptr ) return nullptr;
+
+  if( node->key_ < lo )                                               // node and its left subtree stay
+  {
+    node->right_ = eraseRange( node->right_, lo, hi, erased );
+    if( node->right_ != nullptr ) node->right_->parent_ = node;
+    Augment::refresh( node );
+    return node;
+  }
+
+  if( hi < node->key_ )                                               // node and its right subtree stay
+  {
+    node->left_ = eraseRange( node->left_, lo, hi, erased );
+    if( node->left_ != nullptr ) node->left_->parent_ = node;
+    Augment::refresh( node );
+    return node;
+  }
+
+  auto left  = eraseRange( node->left_,  lo, hi, erased );
+  auto right = eraseRange( node->right_, lo, hi, erased );
+
+  delete node;
+  ++erased;
+
+  return join( left, right );
+}
+
+
+
+
+// Lifts the smallest node of right up to be the joined subtree's root, with left and the rest of right as its children.  Those
+// sit exactly one level below the root, as they did below the deleted node whose place the root takes, and the lifted node's
+// right child moves up into its place:  no node ends up deeper than before, and the joined subtree is only one level taller
+// than the taller of the two.
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::join( Node<Key, Value, Augment> * left, Node<Key, Value, Augment> * right )
+{
+  if( left  == nullptr ) return right;
+  if( right == nullptr ) return left;
+
+  auto first = right;
+  while( first->left_ != nullptr )  first = first->left_;
+
+  if( first != right )                                                // unlink first, its right subtree taking its place
+  {
+    first->parent_->left_ = first->right_;
+    if( first->right_ != nullptr ) first->right_->parent_ = first->parent_;
+
+    for( auto cur = first->parent_; ; cur = cur->parent_ )             // right's left spine, from first's old parent up, lost first
+    {
+      Augment::refresh( cur );
+      if( cur == right ) break;
+    }
+
+    first->right_  = right;
+    right->parent_ = first;
+  }
+
+  first->left_  = left;
+  left->parent_ = first;
+  Augment::refresh( first );
+
+  return first;
+}
+
+
+
+
+// Every node has to be shown to predicate, so rather than a search and a successor copy per match, the whole tree is flattened
+// into its in-order chain once (as rebuild() does), matches are unlinked and freed as the chain is walked, and the survivors
+// are relinked into a perfectly balanced tree:  O(n) with no allocation.
+template <typename Key, typename Value, typename Augment>
+template <typename Predicate>
+std::size_t BinarySearchTree<Key, Value, Augment>::eraseIf( Predicate predicate )
+{
+  if( root_ == nullptr ) return 0;
+
+  std::size_t count  = 0;
+  std::size_t erased = 0;
+  auto        head   = flatten( root_, count );
+
+  Node<Key, Value, Augment> ** link = &head;                          // the right link that points at the next node to test
+  while( *link != nullptr )
+  {
+    auto node = *link;
+
+    if( predicate( static_cast<const Key &>( node->key_ ), static_cast<const Value &>( node->value_ ) ) )
+    {
+      *link = node->right_;
+      delete node;
+      ++erased;
+    }
+    else link = &node->right_;
+  }
+
+  root_ = buildBalanced( head, count - erased );
+  if( root_ != nullptr ) root_->parent_ = nullptr;
+
+  removed( erased );
+  return erased;
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Print
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::printInorder() const
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::printInorder() const
 {
   printInorder( root_ );
 }
@@ -345,8 +710,8 @@ void BinarySearchTree<Key, Value>::printInorder() const
 
 
 //  zyBook Figure 7.7.1: BST inorder traversal algorithm.
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::printInorder( Node<Key, Value> * node ) const
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::printInorder( Node<Key, Value, Augment> * node ) const
 {
   if( node == nullptr ) return;
 
@@ -358,11 +723,170 @@ void BinarySearchTree<Key, Value>::printInorder( Node<Key, Value> * node ) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+//  Visit
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Augment>
+template <typename Function>
+void BinarySearchTree<Key, Value, Augment>::visitInorder( Function visit ) const
+{
+  visitInorder( root_, visit );
+}
+
+
+
+
+//  zyBook Figure 7.7.1: BST inorder traversal algorithm, generalized from printing to any action
+template <typename Key, typename Value, typename Augment>
+template <typename Function>
+void BinarySearchTree<Key, Value, Augment>::visitInorder( Node<Key, Value, Augment> * node, Function & visit ) const
+{
+  if( node == nullptr ) return;
+
+  visitInorder( node->left_, visit );
+  visit( node->key_, node->value_ );
+  visitInorder( node->right_, visit );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Cursor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Augment>
+typename BinarySearchTree<Key, Value, Augment>::Cursor BinarySearchTree<Key, Value, Augment>::cursor() const
+{
+  auto node = root_;
+  while( node != nullptr  &&  node->left_ != nullptr )  node = node->left_;
+
+  return Cursor( this, node );
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+const Key & BinarySearchTree<Key, Value, Augment>::Cursor::key() const
+{
+  if( node_ == nullptr ) throw std::out_of_range( "Cursor is past the end" );
+  return node_->key_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+const Value & BinarySearchTree<Key, Value, Augment>::Cursor::value() const
+{
+  if( node_ == nullptr ) throw std::out_of_range( "Cursor is past the end" );
+  return node_->value_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+typename BinarySearchTree<Key, Value, Augment>::Cursor & BinarySearchTree<Key, Value, Augment>::Cursor::next()
+{
+  if( node_ != nullptr ) node_ = successor( node_ );
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+typename BinarySearchTree<Key, Value, Augment>::Cursor & BinarySearchTree<Key, Value, Augment>::Cursor::prev()
+{
+  if( node_ == nullptr )                                              // past the end:  step back to the last node
+  {
+    node_ = tree_->root_;
+    while( node_ != nullptr  &&  node_->right_ != nullptr )  node_ = node_->right_;
+  }
+  else if( auto previous = predecessor( node_ ) )  node_ = previous;
+
+  return *this;
+}
+
+
+
+
+// Every left subtree holds keys below its parent's, and every right subtree keys at or above it.  So a subtree hanging to
+// the right of its parent p cannot hold anything at or after the target when p's key is below it;  one hanging to the left
+// of p cannot miss anything when the target is at or below p's key, with p itself the answer if nothing in the subtree
+// qualifies.  Climb from the cursor until reaching such a subtree on the side the target lies, then descend as usual.
+template <typename Key, typename Value, typename Augment>
+bool BinarySearchTree<Key, Value, Augment>::Cursor::seek( const Key & key )
+{
+  auto top      = tree_->root_;
+  auto fallback = static_cast<Node<Key, Value, Augment> *>( nullptr );  // the answer if nothing under top qualifies
+
+  if( node_ != nullptr )
+  {
+    bool forward = node_->key_ < key;                                   // else the cursor's node already qualifies
+
+    for( top = node_; top->parent_ != nullptr; top = top->parent_ )
+    {
+      auto parent = top->parent_;
+
+      if( forward  &&  top == parent->left_   &&  !( parent->key_ < key ) )  { fallback = parent;  break; }
+      if( !forward &&  top == parent->right_  &&     parent->key_ < key   )  break;
+    }
+  }
+
+  node_ = fallback;
+  for( auto cur = top; cur != nullptr; )
+  {
+    if( cur->key_ < key )  cur = cur->right_;
+    else                 { node_ = cur;  cur = cur->left_; }
+  }
+
+  return node_ != nullptr  &&  node_->key_ == key;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::successor( Node<Key, Value, Augment> * node )
+{
+  if( node->right_ != nullptr )
+  {
+    node = node->right_;
+    while( node->left_ != nullptr )  node = node->left_;
+    return node;
+  }
+
+  while( node->parent_ != nullptr  &&  node == node->parent_->right_ )  node = node->parent_;
+  return node->parent_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::predecessor( Node<Key, Value, Augment> * node )
+{
+  if( node->left_ != nullptr )
+  {
+    node = node->left_;
+    while( node->right_ != nullptr )  node = node->right_;
+    return node;
+  }
+
+  while( node->parent_ != nullptr  &&  node == node->parent_->left_ )  node = node->parent_;
+  return node->parent_;
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Height
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Key, typename Value>
-int BinarySearchTree<Key, Value>::getHeight() const
+template <typename Key, typename Value, typename Augment>
+int BinarySearchTree<Key, Value, Augment>::getHeight() const
 {
   return getHeight( root_ );
 }
@@ -371,8 +895,8 @@ int BinarySearchTree<Key, Value>::getHeight() const
 
 
 //  zyBook Figure 7.8.3: BSTGetHeight algorithm.
-template <typename Key, typename Value>
-int BinarySearchTree<Key, Value>::getHeight( Node<Key, Value> * node ) const
+template <typename Key, typename Value, typename Augment>
+int BinarySearchTree<Key, Value, Augment>::getHeight( Node<Key, Value, Augment> * node ) const
 {
   if( node == nullptr ) return -1;
 
@@ -385,27 +909,224 @@ int BinarySearchTree<Key, Value>::getHeight( Node<Key, Value> * node ) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+//  Size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Augment>
+std::size_t BinarySearchTree<Key, Value, Augment>::size() const
+{ return size_; }
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+std::size_t BinarySearchTree<Key, Value, Augment>::countNodes( Node<Key, Value, Augment> * node )
+{
+  if( node == nullptr ) return 0;
+
+  return 1 + countNodes( node->left_ ) + countNodes( node->right_ );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Scapegoat rebuilding
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::setScapegoatAlpha( double alpha )
+{
+  if( alpha != 0.0  &&  !( alpha > 0.5  &&  alpha < 1.0 ) ) throw std::invalid_argument( "Scapegoat alpha must be 0 or between 0.5 and 1" );
+
+  alpha_   = alpha;
+  maxSize_ = size_;
+
+  if( alpha_ > 0.0  &&  root_ != nullptr ) rebuild( root_ );          // start from a balanced tree so the height bound holds from here on
+}
+
+
+
+
+// If every ancestor of node kept at most alpha of its subtree's nodes on node's side, node could be no deeper than log base
+// 1/alpha of the tree's size.  So when it is deeper, some ancestor is lopsided:  climb until the first such ancestor is found,
+// counting subtree sizes along the way, and rebuild it.  Rebuilding a subtree of m nodes costs O(m), but that many inserts must
+// land in it before it can become lopsided again, so inserts remain O(log n) amortized.
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::rebalanceFrom( Node<Key, Value, Augment> * node )
+{
+  std::size_t depth = 0;
+  for( auto cur = node; cur->parent_ != nullptr; cur = cur->parent_ ) ++depth;
+
+  if( depth <= std::log( static_cast<double>( size_ ) ) / std::log( 1.0 / alpha_ ) ) return;     // Within the height bound
+
+  auto        child     = node;
+  std::size_t childSize = 1;
+  for( auto parent = node->parent_; parent != nullptr; child = parent, parent = parent->parent_ )
+  {
+    auto siblingSize = countNodes( parent->left_ == child ? parent->right_ : parent->left_ );
+    auto parentSize  = childSize + siblingSize + 1;
+
+    if( childSize > alpha_ * parentSize )                             // Found the scapegoat
+    {
+      rebuild( parent );
+      return;
+    }
+
+    childSize = parentSize;
+  }
+}
+
+
+
+
+// Rebuilds in place without allocating:  first rotate left children up until the subtree is a chain of right links in
+// ascending key order (the Day-Stout-Warren "tree to vine" pass), then relink that chain into a perfectly balanced subtree.
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::rebuild( Node<Key, Value, Augment> * node )
+{
+  auto parent = node->parent_;
+  bool isLeft = parent != nullptr  &&  parent->left_ == node;
+
+  std::size_t count   = 0;
+  auto        head    = flatten( node, count );
+  auto        subtree = buildBalanced( head, count );
+  subtree->parent_    = parent;
+
+  if     ( parent == nullptr )  root_          = subtree;
+  else if( isLeft )             parent->left_  = subtree;
+  else                          parent->right_ = subtree;
+
+  refreshToRoot( parent );                                            // the subtree's shape changed even though its nodes did not
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::flatten( Node<Key, Value, Augment> * node, std::size_t & count )
+{
+  Node<Key, Value, Augment> *  head = node;
+  Node<Key, Value, Augment> ** link = &head;                          // the right link that points at cur
+  auto                         cur  = node;
+
+  while( cur != nullptr )
+  {
+    if( cur->left_ == nullptr )                                       // cur is next in order, move along the chain
+    {
+      ++count;
+      link = &cur->right_;
+      cur  = cur->right_;
+    }
+    else                                                              // rotate right:  cur's left child takes its place
+    {
+      auto left    = cur->left_;
+      cur->left_   = left->right_;
+      left->right_ = cur;
+      cur          = left;
+      *link        = left;
+    }
+  }
+
+  return head;
+}
+
+
+
+
+// Consumes count nodes from the front of list:  the first half become the left subtree, the next one the root, and the rest the
+// right subtree.  Recursion depth is only log2( count ).
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::buildBalanced( Node<Key, Value, Augment> * & list, std::size_t count )
+{
+  if( count == 0 ) return nullptr;
+
+  auto left = buildBalanced( list, count / 2 );
+
+  auto root = list;
+  list      = list->right_;
+
+  root->left_  = left;
+  root->right_ = buildBalanced( list, count - count / 2 - 1 );
+
+  if( root->left_  != nullptr ) root->left_ ->parent_ = root;
+  if( root->right_ != nullptr ) root->right_->parent_ = root;
+  Augment::refresh( root );
+
+  return root;
+}
+
+
+
+
+// The middle node is the root, and the halves either side are independent subtrees:  while threads remain, the left half is
+// built on a thread of its own
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::buildBalanced( Node<Key, Value, Augment> ** nodes, std::size_t count, unsigned threads )
+{
+  if( count == 0 ) return nullptr;
+
+  auto middle = count / 2;
+  auto root   = nodes[middle];
+
+  if( threads > 1 )
+  {
+    std::thread leftBuilder( [&] { root->left_ = buildBalanced( nodes, middle, threads / 2 ); } );
+    root->right_ = buildBalanced( nodes + middle + 1, count - middle - 1, threads - threads / 2 );
+    leftBuilder.join();
+  }
+  else
+  {
+    root->left_  = buildBalanced( nodes,              middle,             1 );
+    root->right_ = buildBalanced( nodes + middle + 1, count - middle - 1, 1 );
+  }
+
+  if( root->left_  != nullptr ) root->left_ ->parent_ = root;
+  if( root->right_ != nullptr ) root->right_->parent_ = root;
+  Augment::refresh( root );
+
+  return root;
+}
+
+
+
+
+template <typename Key, typename Value, typename Augment>
+template <typename Function>
+void BinarySearchTree<Key, Value, Augment>::runInParallel( unsigned tasks, Function task )
+{
+  std::vector<std::thread> workers;
+  for( unsigned i = 1; i < tasks; ++i )  workers.emplace_back( task, i );
+
+  if( tasks > 0 ) task( 0 );                                          // the calling thread takes a share too
+  for( auto & worker : workers )  worker.join();
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //   Constructors, destructor, assignments
 ////////////////////////////////////////////////////////////////////////////////
-template <typename Key, typename Value>
-BinarySearchTree<Key, Value>::BinarySearchTree( const BinarySearchTree & original )
+template <typename Key, typename Value, typename Augment>
+BinarySearchTree<Key, Value, Augment>::BinarySearchTree( const BinarySearchTree & original )
+  : size_( original.size_ ), maxSize_( original.maxSize_ ), alpha_( original.alpha_ )
 { root_ = makeCopy( original.root_ ); }
 
 
 
 
-template <typename Key, typename Value>
-Node<Key, Value> * BinarySearchTree<Key, Value>::makeCopy( Node<Key, Value> * originalNode )
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment> * BinarySearchTree<Key, Value, Augment>::makeCopy( Node<Key, Value, Augment> * originalNode )
 {
   if( originalNode == nullptr ) return nullptr;
 
-  auto node    = new Node<Key, Value>( originalNode->key_, originalNode->value_ );
+  auto node    = new Node<Key, Value, Augment>( originalNode->key_, originalNode->value_ );
   node->left_  = makeCopy( originalNode->left_ );
   node->right_ = makeCopy( originalNode->right_ );
 
   if( node->left_  != nullptr ) node->left_ ->parent_ = node;
   if( node->right_ != nullptr ) node->right_->parent_ = node;
+  Augment::refresh( node );
 
   return node;
 }
@@ -415,12 +1136,13 @@ Node<Key, Value> * BinarySearchTree<Key, Value>::makeCopy( Node<Key, Value> * or
 
 // Passing by value delegates copying the tree to the copy constructor, keeping the "copy" knowledge
 // in one place.  (Copy and swap idiom)
-template <typename Key, typename Value>
-BinarySearchTree<Key, Value> & BinarySearchTree<Key, Value>::operator=( BinarySearchTree rhs )
+template <typename Key, typename Value, typename Augment>
+BinarySearchTree<Key, Value, Augment> & BinarySearchTree<Key, Value, Augment>::operator=( BinarySearchTree rhs )
 {
-  auto temp = rhs.root_;
-  rhs.root_ = root_;
-  root_     = temp;
+  std::swap( root_,    rhs.root_    );
+  std::swap( size_,    rhs.size_    );
+  std::swap( maxSize_, rhs.maxSize_ );
+  std::swap( alpha_,   rhs.alpha_   );
 
   return *this;
 }
@@ -428,25 +1150,27 @@ BinarySearchTree<Key, Value> & BinarySearchTree<Key, Value>::operator=( BinarySe
 
 
 
-template <typename Key, typename Value>
-BinarySearchTree<Key, Value>::~BinarySearchTree()
+template <typename Key, typename Value, typename Augment>
+BinarySearchTree<Key, Value, Augment>::~BinarySearchTree()
 { clear(); }
 
 
 
 
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::clear()
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::clear()
 {
   clear( root_ );
-  root_ = nullptr;
+  root_    = nullptr;
+  size_    = 0;
+  maxSize_ = 0;
 }
 
 
 
 
-template <typename Key, typename Value>
-void BinarySearchTree<Key, Value>::clear( Node<Key, Value> * node )
+template <typename Key, typename Value, typename Augment>
+void BinarySearchTree<Key, Value, Augment>::clear( Node<Key, Value, Augment> * node )
 {
   if( node == nullptr ) return;
 
@@ -460,18 +1184,18 @@ void BinarySearchTree<Key, Value>::clear( Node<Key, Value> * node )
 
 
 /*******************************************************************************
-**  Node<Key, Value>  Definitions
+**  Node<Key, Value, Augment>  Definitions
 *******************************************************************************/
-template <typename Key, typename Value>
-Node<Key, Value>::Node( const Key & key, const Value & value )
+template <typename Key, typename Value, typename Augment>
+Node<Key, Value, Augment>::Node( const Key & key, const Value & value )
   : key_( key ), value_( value )
 {}
 
 
 
 
-template <typename Key, typename Value>
-std::ostream & operator<<( std::ostream & stream, const Node<Key, Value> & node )
+template <typename Key, typename Value, typename Augment>
+std::ostream & operator<<( std::ostream & stream, const Node<Key, Value, Augment> & node )
 {
   stream << "Key: \"" << node.key_ << "\",  Value: \"" << node.value_ << "\"\n";
   return stream;
@@ -1,5 +1,9 @@
 #include <string>
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
 
 #include "BinarySearchTree.hpp"
 
@@ -32,6 +36,86 @@ int main() {
 
   gradeBook.remove( "Ellen" );
   if( gradeBook.getHeight() != 2 ) std::cerr << "Tree height does not match expected\n";
+
+
+  // Sorted inserts degenerate a plain BST into a list;  scapegoat mode rebuilds lopsided subtrees as they appear
+  BinarySearchTree<unsigned, unsigned> plain, scapegoat;
+  scapegoat.setScapegoatAlpha( 0.7 );
+  for( unsigned i = 0; i < 2000; ++i ) { plain.insert( i, i );  scapegoat.insert( i, i ); }
+
+  std::cout << "Height after 2000 sorted inserts:  plain " << plain.getHeight() << ",  scapegoat " << scapegoat.getHeight() << '\n';
+  if( scapegoat.getHeight() > 21 ) std::cerr << "Scapegoat height exceeds log base 1/0.7 of size\n";   // log(2000) / log(1/0.7) = 21.3
+
+  // Range erases lift survivors up rather than stacking them, so the tree stays within the bound
+  for( unsigned lo = 100; lo < 2000; lo += 400 ) scapegoat.eraseRange( lo, lo + 99 );
+  std::cout << "Height after erasing 5 ranges of 100 keys:  scapegoat " << scapegoat.getHeight() << '\n';
+  if( scapegoat.getHeight() > 20 ) std::cerr << "Scapegoat height exceeds log base 1/0.7 of size after eraseRange\n";   // log(1500) / log(1/0.7) = 20.5
+
+  for( unsigned i = 0; i < 1500; ++i ) scapegoat.remove( i );
+  if( scapegoat.size() != 400  ||  scapegoat.search( 1999 ) != 1999 ) std::cerr << "Scapegoat contents do not match expected\n";
+
+
+  // Ingest an unsorted batch one insert at a time, and all at once
+  std::mt19937                               random( 42 );
+  std::vector<std::pair<unsigned, unsigned>> batch( 1000000 );
+  for( auto & entry : batch )  entry = { static_cast<unsigned>( random() ), 0u };
+
+  using Clock = std::chrono::steady_clock;
+  BinarySearchTree<unsigned, unsigned> oneByOne, batched;
+
+  auto start = Clock::now();
+  for( const auto & entry : batch )  oneByOne.insert( entry.first, entry.second );
+  auto middle = Clock::now();
+  batched.insertBatch( batch.begin(), batch.end() );
+  auto end = Clock::now();
+
+  std::cout << "Ingesting " << batch.size() << " unsorted keys:  insert() "
+            << std::chrono::duration<double>( middle - start ).count() << " s (height " << oneByOne.getHeight() << "),  insertBatch() "
+            << std::chrono::duration<double>( end - middle   ).count() << " s (height " << batched.getHeight()  << ")\n";
+  if( batched.size() != oneByOne.size()  ||  batched.getHeight() != 19 ) std::cerr << "Batched tree does not match expected\n";   // a million keys need 20 levels
+
+
+  // Drop the lower half of the keys one remove() at a time, and with one eraseRange()
+  std::vector<unsigned> lowerHalf;
+  oneByOne.visitInorder( [&]( unsigned key, unsigned ) { if( key < 1u << 31 ) lowerHalf.push_back( key ); } );
+
+  start = Clock::now();
+  for( auto key : lowerHalf )  oneByOne.remove( key );
+  middle = Clock::now();
+  auto erased = batched.eraseRange( 0, ( 1u << 31 ) - 1 );
+  end = Clock::now();
+
+  std::cout << "Removing " << erased << " keys:  remove() " << std::chrono::duration<double>( middle - start ).count()
+            << " s,  eraseRange() " << std::chrono::duration<double>( end - middle ).count() << " s\n";
+  if( erased != lowerHalf.size()  ||  batched.size() != oneByOne.size() ) std::cerr << "Range erase does not match expected\n";
+
+  auto odd = batched.eraseIf( []( unsigned key, unsigned ) { return key % 2 == 1; } );
+  std::size_t oddLeft = 0;
+  batched.visitInorder( [&]( unsigned key, unsigned ) { oddLeft += key % 2; } );
+  if( odd + batched.size() != oneByOne.size()  ||  oddLeft != 0 ) std::cerr << "Predicate erase does not match expected\n";
+
+
+  // Look up keys that drift a few places at a time, searching from the root each time, and seeking from a cursor
+  BinarySearchTree<unsigned, unsigned> evens;
+  std::vector<std::pair<unsigned, unsigned>> evenKeys;
+  for( unsigned i = 0; i < 1000000; ++i )  evenKeys.emplace_back( 2 * i, i );
+  evens.insertBatch( evenKeys.begin(), evenKeys.end() );
+
+  std::vector<unsigned> walk( 1000000 );
+  unsigned position = 1000000;
+  for( auto & key : walk )  key = position += static_cast<int>( random() % 17 ) - 8;   // about half the keys are odd:  misses
+
+  std::size_t hits = 0, seekHits = 0;
+  start = Clock::now();
+  for( auto key : walk )  hits += evens.contains( key );
+  middle = Clock::now();
+  auto finger = evens.cursor();
+  for( auto key : walk )  seekHits += finger.seek( key );
+  end = Clock::now();
+
+  std::cout << "Drifting lookups:  contains() " << std::chrono::duration<double>( middle - start ).count()
+            << " s,  Cursor::seek() " << std::chrono::duration<double>( end - middle ).count() << " s\n";
+  if( hits != seekHits  ||  !finger.valid()  ||  finger.key() < walk.back()  ||  finger.prev().key() >= walk.back() ) std::cerr << "Cursor does not match expected\n";
 }
 
 
@@ -0,0 +1,244 @@
+#pragma once
+#include <cmath>       // exp(), log(), pow(), sqrt()
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t, uint64_t
+#include <functional>  // hash
+#include <utility>     // swap()
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define BLOCKED_BLOOM_FILTER_USING_AVX2
+#endif
+
+// A blocked ("split block") Bloom filter.  The bit array is divided into 64 byte blocks, each exactly one cache line of eight
+// 64-bit words.  A key's hash picks one block and then sets (or tests) one bit in each of the block's eight words, so every
+// add() and mayContain() touches a single cache line.  The eight bit positions come from multiplying the hash by eight odd
+// salts, which with AVX2 is one vector multiply, one variable shift, and one test of the whole block.
+//
+// mayContain() never returns false for a key that was added, but may return true for a key that was not (a false positive).
+// The constructor sizes the filter so the expected false positive rate at the expected number of keys is at most the one
+// requested.  Keys cannot be removed;  build a new filter instead.
+
+
+/*******************************************************************************
+**  Blocked Bloom Filter Abstract Data Type Definition
+*******************************************************************************/
+template <typename Key, typename Hash = std::hash<Key>>
+class BlockedBloomFilter {
+  public:
+    explicit BlockedBloomFilter( size_t expectedKeys = 1024, double falsePositiveRate = 0.01 );
+    BlockedBloomFilter             ( const BlockedBloomFilter & original );
+    BlockedBloomFilter & operator= (       BlockedBloomFilter   rhs      );  // NOTE: INTENTIONALLY PASSED BY VALUE (delegates to copy constructor)
+   ~BlockedBloomFilter             ();
+
+    void   add       ( const Key & key );
+    bool   mayContain( const Key & key ) const;                            // false means definitely not added;  true means probably added
+    void   clear     ();                                                   // Removes all keys, keeping the current size
+
+    size_t blockCount() const;
+
+
+  private:
+    static constexpr size_t WORDS_PER_BLOCK = 8;                           // 8 x 64 bits = one 64 byte cache line
+
+    struct alignas(64) Block {
+      uint64_t words_[WORDS_PER_BLOCK];
+    };
+
+    Block * blocks_     = nullptr;
+    size_t  blockCount_ = 0;
+    Hash    hasher_;
+
+    // Helper functions
+    uint64_t hashOf  ( const Key & key ) const;
+    Block &  blockFor( uint64_t hash )   const;
+
+    static double estimatedFalsePositiveRate( double keysPerBlock );
+};
+
+
+/*******************************************************************************
+**  BlockedBloomFilter<Key, Hash>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Hashing
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Hash>
+uint64_t BlockedBloomFilter<Key, Hash>::hashOf( const Key & key ) const
+{
+  uint64_t hash = static_cast<uint64_t>( hasher_( key ) );                 // mix:  std::hash may be the identity for integers
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+
+
+
+// The upper 32 bits pick the block (multiply-shift maps them onto [0, blockCount_) without a division);  the lower 32 bits
+// pick the bits within the block
+template <typename Key, typename Hash>
+typename BlockedBloomFilter<Key, Hash>::Block & BlockedBloomFilter<Key, Hash>::blockFor( uint64_t hash ) const
+{ return blocks_[ ( ( hash >> 32 ) * blockCount_ ) >> 32 ]; }
+
+
+
+
+namespace BlockedBloomFilterDetail {
+  alignas(32) constexpr uint32_t SALTS[8] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                              0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Add / Query
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Hash>
+void BlockedBloomFilter<Key, Hash>::add( const Key & key )
+{
+  auto   hash  = hashOf( key );
+  auto & block = blockFor( hash );
+  auto   low   = static_cast<uint32_t>( hash );
+
+  #if defined(BLOCKED_BLOOM_FILTER_USING_AVX2)
+    auto salts = _mm256_load_si256( reinterpret_cast<const __m256i *>( BlockedBloomFilterDetail::SALTS ) );
+    auto bits  = _mm256_srli_epi32( _mm256_mullo_epi32( _mm256_set1_epi32( static_cast<int>( low ) ), salts ), 26 );   // eight 6 bit positions
+    auto ones  = _mm256_set1_epi64x( 1 );
+    auto lo    = _mm256_sllv_epi64( ones, _mm256_cvtepu32_epi64( _mm256_castsi256_si128     ( bits )    ) );
+    auto hi    = _mm256_sllv_epi64( ones, _mm256_cvtepu32_epi64( _mm256_extracti128_si256   ( bits, 1 ) ) );
+    auto words = reinterpret_cast<__m256i *>( block.words_ );
+    _mm256_store_si256( words,     _mm256_or_si256( _mm256_load_si256( words     ), lo ) );
+    _mm256_store_si256( words + 1, _mm256_or_si256( _mm256_load_si256( words + 1 ), hi ) );
+
+  #else
+    for( size_t i = 0; i < WORDS_PER_BLOCK; ++i )
+      block.words_[i] |= uint64_t( 1 ) << ( ( low * BlockedBloomFilterDetail::SALTS[i] ) >> 26 );
+
+  #endif
+}
+
+
+
+
+template <typename Key, typename Hash>
+bool BlockedBloomFilter<Key, Hash>::mayContain( const Key & key ) const
+{
+  auto   hash  = hashOf( key );
+  auto & block = blockFor( hash );
+  auto   low   = static_cast<uint32_t>( hash );
+
+  #if defined(BLOCKED_BLOOM_FILTER_USING_AVX2)
+    auto salts = _mm256_load_si256( reinterpret_cast<const __m256i *>( BlockedBloomFilterDetail::SALTS ) );
+    auto bits  = _mm256_srli_epi32( _mm256_mullo_epi32( _mm256_set1_epi32( static_cast<int>( low ) ), salts ), 26 );
+    auto ones  = _mm256_set1_epi64x( 1 );
+    auto lo    = _mm256_sllv_epi64( ones, _mm256_cvtepu32_epi64( _mm256_castsi256_si128     ( bits )    ) );
+    auto hi    = _mm256_sllv_epi64( ones, _mm256_cvtepu32_epi64( _mm256_extracti128_si256   ( bits, 1 ) ) );
+    auto words = reinterpret_cast<const __m256i *>( block.words_ );
+    return _mm256_testc_si256( _mm256_load_si256( words     ), lo )       // testc:  every bit of the mask is set in the block
+       &&  _mm256_testc_si256( _mm256_load_si256( words + 1 ), hi );
+
+  #else
+    uint64_t missing = 0;
+    for( size_t i = 0; i < WORDS_PER_BLOCK; ++i )
+      missing |= ~block.words_[i] & ( uint64_t( 1 ) << ( ( low * BlockedBloomFilterDetail::SALTS[i] ) >> 26 ) );
+    return missing == 0;
+
+  #endif
+}
+
+
+
+
+template <typename Key, typename Hash>
+void BlockedBloomFilter<Key, Hash>::clear()
+{
+  for( size_t b = 0; b < blockCount_; ++b )
+    for( auto & word : blocks_[b].words_ )  word = 0;
+}
+
+
+
+
+template <typename Key, typename Hash>
+size_t BlockedBloomFilter<Key, Hash>::blockCount() const
+{ return blockCount_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Sizing
+////////////////////////////////////////////////////////////////////////////////
+// Keys land in blocks unevenly (Poisson distributed), and crowded blocks dominate the false positive rate, so average the
+// per-block rate over that distribution rather than using the textbook formula for an unblocked filter
+template <typename Key, typename Hash>
+double BlockedBloomFilter<Key, Hash>::estimatedFalsePositiveRate( double keysPerBlock )
+{
+  double rate        = 0.0;
+  double probability = std::exp( -keysPerBlock );                          // Poisson probability of a block holding 0 keys
+  auto   limit       = static_cast<size_t>( keysPerBlock + 10.0 * std::sqrt( keysPerBlock ) + 20.0 );
+
+  for( size_t keys = 0; keys <= limit; ++keys )
+  {
+    double bitSet = 1.0 - std::pow( 1.0 - 1.0 / 64.0, static_cast<double>( keys ) );   // chance one given bit of a word is set
+    rate        += probability * std::pow( bitSet, static_cast<double>( WORDS_PER_BLOCK ) );
+    probability *= keysPerBlock / static_cast<double>( keys + 1 );
+  }
+
+  return rate;
+}
+
+
+
+
+template <typename Key, typename Hash>
+BlockedBloomFilter<Key, Hash>::BlockedBloomFilter( size_t expectedKeys, double falsePositiveRate )
+{
+  if( expectedKeys == 0 ) expectedKeys = 1;
+
+  // Start from the unblocked optimum and add blocks until the blocked estimate meets the target
+  double bitsPerKey = -std::log( falsePositiveRate ) / ( std::log( 2.0 ) * std::log( 2.0 ) );
+  blockCount_ = static_cast<size_t>( expectedKeys * bitsPerKey / 512.0 ) + 1;
+  while( estimatedFalsePositiveRate( static_cast<double>( expectedKeys ) / blockCount_ ) > falsePositiveRate )  blockCount_ += blockCount_ / 16 + 1;
+
+  blocks_ = new Block[blockCount_];                                        // C++17 aligned new honors alignas(64)
+  clear();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Hash>
+BlockedBloomFilter<Key, Hash>::BlockedBloomFilter( const BlockedBloomFilter & original )
+  : blocks_( new Block[original.blockCount_] ), blockCount_( original.blockCount_ ), hasher_( original.hasher_ )
+{
+  for( size_t b = 0; b < blockCount_; ++b )  blocks_[b] = original.blocks_[b];
+}
+
+
+
+
+// Passing by value delegates copying to the copy constructor, keeping the "copy" knowledge in one place.  (Copy and swap idiom)
+template <typename Key, typename Hash>
+BlockedBloomFilter<Key, Hash> & BlockedBloomFilter<Key, Hash>::operator=( BlockedBloomFilter rhs )
+{
+  std::swap( blocks_,     rhs.blocks_     );
+  std::swap( blockCount_, rhs.blockCount_ );
+  std::swap( hasher_,     rhs.hasher_     );
+
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Hash>
+BlockedBloomFilter<Key, Hash>::~BlockedBloomFilter()
+{ delete[] blocks_; }
@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>     // size_t
+#include <stdexcept>
+
+#include "BinarySearchTree.hpp"
+#include "BlockedBloomFilter.hpp"
+
+// A BinarySearchTree fronted by a BlockedBloomFilter of its keys.  A search for a key the filter has never seen is answered
+// "not found" after one cache line probe instead of a full root-to-leaf walk.  Searches for keys that are present, and the
+// occasional false positive, still walk the tree.
+//
+// The filter only ever grows:  removing a key leaves its bits set, so removes gradually make the filter less selective.  After
+// removes equal to rebuildFraction of the keys (or when inserts exceed the capacity the filter was sized for) the filter is
+// rebuilt from the tree's current keys.  FilterStatistics reports how often the filter saved a tree walk.
+
+
+/*******************************************************************************
+**  Bloom Filtered Binary Search Tree Abstract Data Type Definition (Duplicate keys allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class BloomFilteredBinarySearchTree {
+  public:
+    struct FilterStatistics {
+      size_t searches       = 0;                                           // calls to search()
+      size_t definiteMisses = 0;                                           // answered by the filter alone, without walking the tree
+      size_t falsePositives = 0;                                           // filter said "maybe", tree walk said "not found"
+      size_t rebuilds       = 0;
+    };
+
+    explicit BloomFilteredBinarySearchTree( size_t expectedKeys = 1024, double falsePositiveRate = 0.01, double rebuildFraction = 0.25 );
+
+    // Queries
+    Value search      ( const Key & key );                                 // Returns the value associated with the first node found matching given key. Throws invalid_argument if key not found
+    void  insert      ( const Key & key, const Value & value );
+    void  remove      ( const Key & key );
+    void  printInorder()                                        const;
+    int   getHeight   ()                                        const;
+
+    void  rebuildFilter();                                                 // Rebuilds the filter from the tree's keys now
+    void  clear        ();
+
+    const FilterStatistics & statistics() const;
+
+
+  private:
+    BinarySearchTree  <Key, Value> tree_;
+    BlockedBloomFilter<Key>        filter_;
+    FilterStatistics               statistics_;
+
+    double falsePositiveRate_;
+    double rebuildFraction_;
+    size_t filterCapacity_;                                                // keys the filter was sized for
+    size_t keysAdded_        = 0;                                          // keys added to the filter since it was built
+    size_t removesSinceBuild_ = 0;
+};
+
+
+/*******************************************************************************
+**  BloomFilteredBinarySearchTree<Key, Value>  Definitions
+*******************************************************************************/
+template <typename Key, typename Value>
+BloomFilteredBinarySearchTree<Key, Value>::BloomFilteredBinarySearchTree( size_t expectedKeys, double falsePositiveRate, double rebuildFraction )
+  : filter_( expectedKeys, falsePositiveRate ),
+    falsePositiveRate_( falsePositiveRate ), rebuildFraction_( rebuildFraction ), filterCapacity_( expectedKeys )
+{}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value BloomFilteredBinarySearchTree<Key, Value>::search( const Key & key )
+{
+  ++statistics_.searches;
+
+  if( !filter_.mayContain( key ) )
+  {
+    ++statistics_.definiteMisses;
+    throw std::invalid_argument( "Key not found" );
+  }
+
+  try
+  {
+    return tree_.search( key );
+  }
+  catch( const std::invalid_argument & )
+  {
+    ++statistics_.falsePositives;
+    throw;
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert / Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void BloomFilteredBinarySearchTree<Key, Value>::insert( const Key & key, const Value & value )
+{
+  tree_.insert( key, value );
+  filter_.add( key );
+
+  if( ++keysAdded_ > filterCapacity_ ) rebuildFilter();                    // over capacity:  resize before the false positive rate climbs
+}
+
+
+
+
+template <typename Key, typename Value>
+void BloomFilteredBinarySearchTree<Key, Value>::remove( const Key & key )
+{
+  if( !filter_.mayContain( key ) ) return;                                 // definitely not in the tree
+
+  auto sizeBefore = tree_.size();
+  tree_.remove( key );
+  if( tree_.size() == sizeBefore ) return;                                 // a false positive:  nothing removed, the filter is no staler
+
+  if( ++removesSinceBuild_ > rebuildFraction_ * keysAdded_ ) rebuildFilter();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Filter maintenance
+////////////////////////////////////////////////////////////////////////////////
+// Sized for twice the current key count so steady growth does not trigger another rebuild right away
+template <typename Key, typename Value>
+void BloomFilteredBinarySearchTree<Key, Value>::rebuildFilter()
+{
+  size_t keyCount = tree_.size();
+
+  filterCapacity_ = keyCount < 512 ? 1024 : 2 * keyCount;
+  filter_         = BlockedBloomFilter<Key>( filterCapacity_, falsePositiveRate_ );
+  tree_.visitInorder( [&]( const Key & key, const Value & ) { filter_.add( key ); } );
+
+  keysAdded_         = keyCount;
+  removesSinceBuild_ = 0;
+  ++statistics_.rebuilds;
+}
+
+
+
+
+template <typename Key, typename Value>
+void BloomFilteredBinarySearchTree<Key, Value>::clear()
+{
+  tree_.clear();
+  filter_.clear();
+  keysAdded_         = 0;
+  removesSinceBuild_ = 0;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Delegated queries
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void BloomFilteredBinarySearchTree<Key, Value>::printInorder() const
+{ tree_.printInorder(); }
+
+
+
+
+template <typename Key, typename Value>
+int BloomFilteredBinarySearchTree<Key, Value>::getHeight() const
+{ return tree_.getHeight(); }
+
+
+
+
+template <typename Key, typename Value>
+const typename BloomFilteredBinarySearchTree<Key, Value>::FilterStatistics & BloomFilteredBinarySearchTree<Key, Value>::statistics() const
+{ return statistics_; }
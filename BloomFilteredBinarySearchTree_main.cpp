@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "BloomFilteredBinarySearchTree.hpp"
+
+
+
+
+// Times searching for keys of which only one in ten is present, counting the misses
+template <typename Tree>
+void benchmark( const char * name, Tree & tree, const std::vector<unsigned> & probes )
+{
+  std::size_t misses = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  for( auto key : probes )
+  {
+    try                                  { tree.search( key ); }
+    catch( const std::invalid_argument & ) { ++misses; }
+  }
+
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "  " << name << ":  " << elapsed.count() / probes.size() << " ns/search  (" << misses << " misses)\n";
+}
+
+
+
+
+int main( int argc, char * argv[] ) {
+  BloomFilteredBinarySearchTree<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  std::string myKey = "Ellen"; // find grade of one student
+  std::cout << "Grade of " << myKey << " is " << studentGrades.search(myKey) << '\n';
+
+  try                                    { studentGrades.search( "Zoe" ); std::cerr << "Search for a missing key did not throw\n"; }
+  catch( const std::invalid_argument & ) {}
+
+  studentGrades.remove( "Ellen" );
+  studentGrades.rebuildFilter();
+  try                                    { studentGrades.search( "Ellen" ); std::cerr << "Removed key was still found\n"; }
+  catch( const std::invalid_argument & ) {}
+
+
+
+  // Usage:  BloomFilteredBinarySearchTree [entries]
+  unsigned count = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  std::mt19937 generator( 131 );
+
+  BinarySearchTree             <unsigned, unsigned> plain;
+  BloomFilteredBinarySearchTree<unsigned, unsigned> filtered( count, 0.01 );
+
+  std::vector<unsigned> keys;
+  for( unsigned i = 0; i < count; ++i )
+  {
+    keys.push_back( generator() | 1u );                                    // odd keys are stored ...
+    plain   .insert( keys.back(), i );
+    filtered.insert( keys.back(), i );
+  }
+
+  std::vector<unsigned> probes;
+  for( unsigned i = 0; i < count; ++i )  probes.push_back( i % 10 == 0 ? keys[generator() % count] : generator() & ~1u );   // ... even keys always miss
+
+  std::cout << count << " entries, 90% of searches miss\n";
+  benchmark( "BinarySearchTree             ", plain,    probes );
+  benchmark( "BloomFilteredBinarySearchTree", filtered, probes );
+
+  auto & statistics = filtered.statistics();
+  std::cout << "  filter answered " << statistics.definiteMisses << " of " << statistics.searches << " searches alone, "
+            << statistics.falsePositives << " false positives ("
+            << 100.0 * statistics.falsePositives / ( statistics.definiteMisses + statistics.falsePositives ) << "% of misses)\n";
+}
+
+
+
+template class BloomFilteredBinarySearchTree<unsigned, float>;
+template class BlockedBloomFilter<unsigned>;
@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>     // min()
+#include <atomic>
+#include <cstddef>       // size_t
+#include <cstdint>       // uint32_t
+#include <cstring>       // memcmp(), memcpy(), memset()
+#include <iostream>
+#include <mutex>         // mutex, lock_guard
+#include <new>           // operator new(), operator delete()
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>       // swap()
+
+// A 24 byte immutable string meant for keys, e.g. BinarySearchTree<CompactString, double>.  Compared with std::string as a
+// key (32 bytes, plus a heap allocation for anything over 15 characters):
+//
+//   o  Strings of up to 22 characters are stored inline, zero padded, with their length in the last byte:  no allocation at all.
+//   o  Longer strings are interned:  one reference counted copy of each distinct string lives in a shared pool, and every
+//      CompactString holding it points there, along with its length and a copy of its first 8 characters.  Keys that repeat
+//      across trees or entries (URLs, say) are stored once.
+//   o  Both forms begin with the string's first characters, zero padded, so a comparison starts with one memcmp() of 8 bytes
+//      straight from the keys themselves, which settles most comparisons without touching the pool.  Two short strings compare
+//      with a single memcmp() of all their bytes, and two interned strings are equal exactly when they point at the same copy.
+//
+// Creating an interned string takes a lock on the pool, as does releasing the last reference to one;  copying one only bumps
+// its reference count.  CompactStrings can be created, copied and destroyed from any thread.
+
+
+/*******************************************************************************
+**  Compact String Definition
+*******************************************************************************/
+class CompactString {
+  public:
+    static constexpr std::size_t INLINE_CAPACITY = 22;
+
+    CompactString             ()                            { std::memset( bytes_, 0, sizeof bytes_ );  tag_ = 0; }
+    CompactString             ( std::string_view text );                  // Throws length_error beyond 4 GB
+    CompactString             ( const std::string & text )  : CompactString( std::string_view( text ) ) {}
+    CompactString             ( const char * text )         : CompactString( std::string_view( text ) ) {}
+    CompactString             ( const CompactString & original );
+    CompactString             ( CompactString && original ) noexcept;
+    CompactString & operator= ( CompactString rhs ) noexcept;             // NOTE: INTENTIONALLY PASSED BY VALUE (Copy and swap idiom)
+   ~CompactString             ();
+
+    // Queries
+    std::size_t      size    ()                            const;
+    const char *     data    ()                            const;         // Not null terminated
+    std::string_view view    ()                            const { return std::string_view( data(), size() ); }
+    std::string      str     ()                            const { return std::string( view() ); }
+    bool             isInline()                            const { return tag_ != INTERNED; }
+    int              compare ( const CompactString & rhs ) const;         // <0, 0 or >0, in the order of std::string::compare()
+
+    friend bool operator==( const CompactString & lhs, const CompactString & rhs );
+    friend bool operator!=( const CompactString & lhs, const CompactString & rhs ) { return !( lhs == rhs );         }
+    friend bool operator< ( const CompactString & lhs, const CompactString & rhs ) { return lhs.compare( rhs ) <  0; }
+    friend bool operator> ( const CompactString & lhs, const CompactString & rhs ) { return lhs.compare( rhs ) >  0; }
+    friend bool operator<=( const CompactString & lhs, const CompactString & rhs ) { return lhs.compare( rhs ) <= 0; }
+    friend bool operator>=( const CompactString & lhs, const CompactString & rhs ) { return lhs.compare( rhs ) >= 0; }
+
+
+  private:
+    static constexpr unsigned char INTERNED = 0xFF;                       // tag_ of an interned string;  otherwise tag_ is the length
+    static constexpr std::size_t   PREFIX   = 8;
+    static constexpr std::size_t   POINTER  = 8;                          // offsets into bytes_ of an interned string's fields
+    static constexpr std::size_t   LENGTH   = 16;
+
+    // Inline:    bytes_ holds the characters, zero padded
+    // Interned:  bytes_[0, 8) holds the first 8 characters, bytes_[8, 16) the pooled copy's address, bytes_[16, 20) the length
+    alignas( 8 ) char bytes_[INLINE_CAPACITY + 1];
+    unsigned char     tag_;
+
+    struct PoolEntry {                                                    // sits just before the characters of each pooled copy
+      std::atomic<std::size_t> references_;
+      std::size_t              length_;
+    };
+
+    struct Pool {
+      std::mutex                           lock_;
+      std::unordered_set<std::string_view> strings_;                      // views of the pooled copies' characters
+    };
+
+    // Helper functions
+    static Pool &      pool   ();
+    static PoolEntry * entryOf( const char * characters );
+    const char *       pooled () const;                                   // Interned strings only
+    void               release();
+};
+
+std::ostream & operator<<( std::ostream & stream, const CompactString & string );
+
+
+/*******************************************************************************
+**  CompactString  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+inline CompactString::CompactString( std::string_view text )
+  : CompactString()
+{
+  if( text.size() <= INLINE_CAPACITY )
+  {
+    std::memcpy( bytes_, text.data(), text.size() );
+    tag_ = static_cast<unsigned char>( text.size() );
+    return;
+  }
+
+  if( text.size() > UINT32_MAX ) throw std::length_error( "CompactString longer than 4 GB" );
+
+  const char * characters;
+  {
+    auto &                      shared = pool();
+    std::lock_guard<std::mutex> guard( shared.lock_ );
+
+    auto found = shared.strings_.find( text );
+    if( found != shared.strings_.end() )
+    {
+      characters = found->data();
+      entryOf( characters )->references_.fetch_add( 1, std::memory_order_relaxed );
+    }
+    else
+    {
+      auto block = static_cast<char *>( ::operator new( sizeof( PoolEntry ) + text.size() ) );
+      new( block ) PoolEntry{ { 1 }, text.size() };
+
+      auto copy = block + sizeof( PoolEntry );
+      std::memcpy( copy, text.data(), text.size() );
+      shared.strings_.insert( std::string_view( copy, text.size() ) );
+      characters = copy;
+    }
+  }
+
+  auto length = static_cast<std::uint32_t>( text.size() );
+  std::memcpy( bytes_,           text.data(),  PREFIX           );
+  std::memcpy( bytes_ + POINTER, &characters,  sizeof characters );
+  std::memcpy( bytes_ + LENGTH,  &length,      sizeof length     );
+  tag_ = INTERNED;
+}
+
+
+
+
+// The original holds a reference, so the pooled copy cannot go away meanwhile:  no lock needed
+inline CompactString::CompactString( const CompactString & original )
+{
+  std::memcpy( bytes_, original.bytes_, sizeof bytes_ );
+  tag_ = original.tag_;
+
+  if( !isInline() ) entryOf( pooled() )->references_.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+
+
+inline CompactString::CompactString( CompactString && original ) noexcept
+{
+  std::memcpy( bytes_, original.bytes_, sizeof bytes_ );
+  tag_ = original.tag_;
+
+  std::memset( original.bytes_, 0, sizeof original.bytes_ );              // leaves the empty string behind
+  original.tag_ = 0;
+}
+
+
+
+
+// Passing by value delegates copying the string to the copy constructor, keeping the "copy" knowledge
+// in one place.  (Copy and swap idiom)
+inline CompactString & CompactString::operator=( CompactString rhs ) noexcept
+{
+  std::swap( bytes_, rhs.bytes_ );                                        // rhs takes the old string away, and releases it
+  std::swap( tag_,   rhs.tag_   );
+
+  return *this;
+}
+
+
+
+
+inline CompactString::~CompactString()
+{ release(); }
+
+
+
+
+// Dropping a reference that is not the last needs no lock.  Dropping the last one must happen under the lock, which new
+// references are only ever created under, so that the copy is not freed while a constructor is picking it up again.
+inline void CompactString::release()
+{
+  if( isInline() ) return;
+
+  auto entry      = entryOf( pooled() );
+  auto references = entry->references_.load( std::memory_order_relaxed );
+
+  while( references > 1 )
+    if( entry->references_.compare_exchange_weak( references, references - 1, std::memory_order_acq_rel ) ) return;
+
+  auto &                      shared = pool();
+  std::lock_guard<std::mutex> guard( shared.lock_ );
+
+  if( entry->references_.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;       // picked up again meanwhile
+
+  shared.strings_.erase( std::string_view( pooled(), entry->length_ ) );
+  entry->~PoolEntry();
+  ::operator delete( entry );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Queries
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CompactString::size() const
+{
+  if( isInline() ) return tag_;
+
+  std::uint32_t length;
+  std::memcpy( &length, bytes_ + LENGTH, sizeof length );
+  return length;
+}
+
+
+
+
+inline const char * CompactString::data() const
+{ return isInline() ? bytes_ : pooled(); }
+
+
+
+
+inline const char * CompactString::pooled() const
+{
+  const char * characters;
+  std::memcpy( &characters, bytes_ + POINTER, sizeof characters );
+  return characters;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Comparisons
+////////////////////////////////////////////////////////////////////////////////
+// Zero padding keeps memcmp() of the padded bytes in string order:  where one string has run out, its padding 0 is at or
+// below whatever the other string has there, and if everything compared is equal the lengths decide.
+inline int CompactString::compare( const CompactString & rhs ) const
+{
+  if( auto result = std::memcmp( bytes_, rhs.bytes_, PREFIX ) )  return result;
+
+  int result;
+  if( isInline()  &&  rhs.isInline() )  result = std::memcmp( bytes_ + PREFIX, rhs.bytes_ + PREFIX, INLINE_CAPACITY + 1 - PREFIX );
+  else if( !isInline()  &&  !rhs.isInline()  &&  pooled() == rhs.pooled() )  return 0;
+  else                                  result = std::memcmp( data(), rhs.data(), std::min( size(), rhs.size() ) );
+
+  if( result != 0 ) return result;
+  return size() < rhs.size() ? -1 : size() > rhs.size() ? 1 : 0;
+}
+
+
+
+
+// Equal strings have equal lengths, so are stored the same way:  inline strings are equal when all their bytes are, and
+// interned strings when they share one pooled copy
+inline bool operator==( const CompactString & lhs, const CompactString & rhs )
+{
+  if( lhs.tag_ != rhs.tag_ ) return false;
+  if( lhs.isInline()       ) return std::memcmp( lhs.bytes_, rhs.bytes_, sizeof lhs.bytes_ ) == 0;
+
+  return lhs.pooled() == rhs.pooled();
+}
+
+
+
+
+inline std::ostream & operator<<( std::ostream & stream, const CompactString & string )
+{ return stream << string.view(); }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Pool
+////////////////////////////////////////////////////////////////////////////////
+inline CompactString::Pool & CompactString::pool()
+{
+  static Pool * shared = new Pool;                                        // never destroyed, so strings in other statics can outlive it safely
+  return *shared;
+}
+
+
+
+
+inline CompactString::PoolEntry * CompactString::entryOf( const char * characters )
+{ return reinterpret_cast<PoolEntry *>( const_cast<char *>( characters ) - sizeof( PoolEntry ) ); }
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>    // pair
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "CompactString.hpp"
+
+
+
+
+// Builds a tree of the given keys and searches it for the probed ones, returning the seconds each took
+template <typename Key>
+std::pair<double, double> timeTree( const std::vector<std::string> & keys, const std::vector<std::size_t> & probes )
+{
+  auto start = std::chrono::steady_clock::now();
+
+  BinarySearchTree<Key, double> tree;
+  for( std::size_t i = 0; i < keys.size(); ++i )  tree.insert( Key( keys[i] ), i );
+
+  std::vector<Key> lookups( probes.size() );                               // converted up front:  only the searches are timed
+  for( std::size_t i = 0; i < probes.size(); ++i )  lookups[i] = Key( keys[probes[i]] );
+  auto built = std::chrono::steady_clock::now();
+
+  double sum = 0;
+  for( const auto & key : lookups )  sum += tree.search( key );
+  auto searched = std::chrono::steady_clock::now();
+
+  if( sum < 0 ) std::cerr << "Unexpected sum\n";
+  return { std::chrono::duration<double>( built - start ).count(), std::chrono::duration<double>( searched - built ).count() };
+}
+
+
+
+
+int main() {
+  BinarySearchTree<CompactString, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+  studentGrades.insert("Wolfeschlegelsteinhausenbergerdorff", 3.9);      // too long to fit inline:  interned
+
+  std::cout << "Grade of Ellen is " << studentGrades.search( "Ellen" ) << '\n';
+  studentGrades.printInorder();
+
+  CompactString shortName( "Kumar" ), longName( "Wolfeschlegelsteinhausenbergerdorff" ), sameLongName( longName.str() );
+  if( !shortName.isInline()  ||  longName.isInline()  ||  longName.data() != sameLongName.data() ) std::cerr << "Storage does not match expected\n";
+  if( !( CompactString( "Chen" ) < CompactString( "Chenoweth" ) ) ) std::cerr << "Ordering does not match expected\n";
+
+
+
+  // Compare std::string and CompactString keys, both short names, which fit inline, and long URLs sharing a prefix.
+  //
+  // Searches gain from the inline bytes and the memcmp() fast paths.  Building a tree of URLs costs more than with std::string,
+  // as each new key is hashed and looked up in the pool under its lock:  interning pays off in memory when keys repeat, and in
+  // searches, not in inserts.  And with every URL starting "https://", the 8 byte prefix never settles a comparison here.
+  std::mt19937             random( 42 );
+  std::vector<std::string> names, urls;
+  for( int i = 0; i < 500000; ++i )
+  {
+    auto id = std::to_string( random() );
+    names.push_back( "student_" + id );                                    // 9 to 18 characters:  inline, but often too long for std::string's own buffer
+    urls .push_back( "https://example.com/users/" + id + "/profile" );     // interned
+  }
+
+  std::vector<std::size_t> probes( 1000000 );
+  for( auto & probe : probes )  probe = random() % names.size();
+
+  std::cout << "\nsizeof:  std::string " << sizeof( std::string ) << ",  CompactString " << sizeof( CompactString ) << '\n';
+
+  auto report = [&]( const char * label, const std::vector<std::string> & keys ) {
+    auto standard = timeTree<std::string>  ( keys, probes );
+    auto compact  = timeTree<CompactString>( keys, probes );
+
+    std::cout << label << ":  build  std::string " << standard.first  << " s,  CompactString " << compact.first  << " s\n"
+              <<          "        search std::string " << standard.second << " s,  CompactString " << compact.second << " s\n";
+  };
+
+  report( "Names", names );
+  report( "URLs ", urls  );
+
+  return 0;
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// An append-only vector of 64 bit unsigned integers, stored compressed: sorted IDs, timestamps
+// and other values that sit close to their neighbours typically take 4 to 16 bits each instead of 64.
+//
+// Values are grouped in blocks of 128. Each block stores its smallest value once (the "frame of
+// reference") and every value as its difference from it, bit-packed in just enough bits for the
+// largest difference: 128 values of b bits fill exactly 2b words. A small header per block (its
+// smallest value, bit width, and where its words start) doubles as a skip index: at() goes
+// straight to the block and unpacks a single value, and lower_bound() on a sorted vector binary
+// searches the headers before unpacking one block.
+//
+// Scans unpack a whole block at a time, with an unpacking loop generated for each bit width, so
+// every shift and mask is a constant the compiler can unroll and vectorize. The last, partly
+// filled block stays uncompressed until it fills up.
+
+// Declaration
+class CompressedIntegerVector {
+private:
+    static const size_t BLOCK = 128;
+
+    struct Block {
+        uint64_t base_;       // smallest value in the block
+        uint32_t offset_;     // index of the block's first word in words_
+        uint8_t bits_;        // bits per value: the block's words are words_[offset_, offset_ + 2 * bits_)
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> tail_;   // values not yet making up a whole block
+
+public:
+    // Getters / Setters
+    uint64_t at(size_t index) const;
+    uint64_t operator[](size_t index) const;
+    void push_back(uint64_t value);
+    size_t size() const;
+    bool empty() const;
+    void clear();
+
+    // Compressed access
+    template <typename Function>
+    void forEach(Function visit) const;               // calls visit(value) for every value in order, unpacking a block at a time
+    size_t lower_bound(uint64_t value) const;         // sorted vectors only: index of the first value not less than value, or size()
+    size_t memoryBytes() const;                       // bytes used by the values and the block headers
+
+private:
+    void compressTail(); // helper function to pack the full tail into a new block
+    void unpack(size_t block, uint64_t* out) const;   // helper function to decode one whole block
+    uint64_t unpackOne(size_t block, size_t index) const;
+
+    template <unsigned Bits>
+    static void unpackBlock(const uint64_t* words, uint64_t base, uint64_t* out);
+
+    template <size_t... Bits>
+    static void unpackDispatch(unsigned bits, const uint64_t* words, uint64_t base, uint64_t* out, std::index_sequence<Bits...>);
+};
+
+inline size_t CompressedIntegerVector::size() const {
+    return blocks_.size() * BLOCK + tail_.size();
+}
+
+inline bool CompressedIntegerVector::empty() const {
+    return size() == 0;
+}
+
+inline void CompressedIntegerVector::clear() {
+    blocks_.clear();
+    words_.clear();
+    tail_.clear();
+}
+
+inline size_t CompressedIntegerVector::memoryBytes() const {
+    return blocks_.size() * sizeof(Block) + (words_.size() + tail_.size()) * sizeof(uint64_t);
+}
+
+// Getter
+inline uint64_t CompressedIntegerVector::at(size_t index) const {
+    if (index >= size()) {
+        throw std::range_error("index out of bounds");
+    }
+    return (*this)[index];
+}
+
+// Overloaded Array-Access Operator
+inline uint64_t CompressedIntegerVector::operator[](size_t index) const {
+    // Note: array bounds intentionally not checking
+    if (index / BLOCK < blocks_.size()) {
+        return unpackOne(index / BLOCK, index % BLOCK);
+    }
+    return tail_[index - blocks_.size() * BLOCK];
+}
+
+inline void CompressedIntegerVector::push_back(uint64_t value) {
+    tail_.push_back(value);
+    if (tail_.size() == BLOCK) {
+        compressTail();
+    }
+}
+
+inline void CompressedIntegerVector::compressTail() {
+    uint64_t base = tail_[0];
+    uint64_t top = tail_[0];
+    for (uint64_t value : tail_) {
+        base = value < base ? value : base;
+        top = value > top ? value : top;
+    }
+
+    unsigned bits = 0;
+    while (bits < 64 && (top - base) >> bits != 0) {
+        bits++;
+    }
+
+    if (words_.size() + 2 * bits > UINT32_MAX) {
+        throw std::length_error("CompressedIntegerVector too large");
+    }
+    Block block{ base, static_cast<uint32_t>(words_.size()), static_cast<uint8_t>(bits) };
+    words_.resize(words_.size() + 2 * bits, 0);
+
+    // value i occupies bits [i * bits, (i + 1) * bits) of the block's words, low bits first
+    uint64_t* words = words_.data() + block.offset_;
+    for (size_t i = 0; i < BLOCK && bits > 0; i++) {
+        const uint64_t delta = tail_[i] - base;
+        const size_t position = i * bits;
+        const unsigned shift = position % 64;
+        words[position / 64] |= delta << shift;
+        if (shift + bits > 64) {
+            words[position / 64 + 1] |= delta >> (64 - shift);
+        }
+    }
+
+    blocks_.push_back(block);
+    tail_.clear();
+}
+
+inline uint64_t CompressedIntegerVector::unpackOne(size_t block, size_t index) const {
+    const Block& header = blocks_[block];
+    const unsigned bits = header.bits_;
+    if (bits == 0) {
+        return header.base_;
+    }
+
+    const uint64_t* words = words_.data() + header.offset_;
+    const size_t position = index * bits;
+    const unsigned shift = position % 64;
+    uint64_t delta = words[position / 64] >> shift;
+    if (shift + bits > 64) {
+        delta |= words[position / 64 + 1] << (64 - shift);
+    }
+    const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    return header.base_ + (delta & mask);
+}
+
+// With Bits a constant, the loop's shifts and masks are constants too, and with the loop fully
+// unrolled the compiler emits straight-line shift, mask and add code for each bit width.
+template <unsigned Bits>
+void CompressedIntegerVector::unpackBlock(const uint64_t* words, uint64_t base, uint64_t* out) {
+    constexpr uint64_t mask = Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << Bits) - 1;
+
+#if defined(__GNUC__)
+#pragma GCC unroll 128
+#endif
+    for (size_t i = 0; i < BLOCK; i++) {
+        if constexpr (Bits == 0) {
+            out[i] = base;
+        } else {
+            const size_t position = i * Bits;
+            const unsigned shift = position % 64;
+            uint64_t delta = words[position / 64] >> shift;
+            if (shift + Bits > 64) {
+                delta |= words[position / 64 + 1] << (64 - shift);
+            }
+            out[i] = base + (delta & mask);
+        }
+    }
+}
+
+template <size_t... Bits>
+void CompressedIntegerVector::unpackDispatch(unsigned bits, const uint64_t* words, uint64_t base, uint64_t* out, std::index_sequence<Bits...>) {
+    using Unpacker = void (*)(const uint64_t*, uint64_t, uint64_t*);
+    static constexpr Unpacker unpackers[] = { &unpackBlock<Bits>... };
+    unpackers[bits](words, base, out);
+}
+
+inline void CompressedIntegerVector::unpack(size_t block, uint64_t* out) const {
+    const Block& header = blocks_[block];
+    unpackDispatch(header.bits_, words_.data() + header.offset_, header.base_, out, std::make_index_sequence<65>());
+}
+
+template <typename Function>
+void CompressedIntegerVector::forEach(Function visit) const {
+    uint64_t values[BLOCK];
+    for (size_t block = 0; block < blocks_.size(); block++) {
+        unpack(block, values);
+        for (size_t i = 0; i < BLOCK; i++) {
+            visit(values[i]);
+        }
+    }
+    for (uint64_t value : tail_) {
+        visit(value);
+    }
+}
+
+// In a sorted vector each block's smallest value is its first, so the headers alone tell which
+// block the answer lies in; only that block is unpacked
+inline size_t CompressedIntegerVector::lower_bound(uint64_t value) const {
+    size_t low = 0, high = blocks_.size();   // find the first block starting at or after value
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (blocks_[middle].base_ < value) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low > 0) {                           // the answer may lie inside the block before it
+        uint64_t values[BLOCK];
+        unpack(low - 1, values);
+        for (size_t i = 0; i < BLOCK; i++) {
+            if (values[i] >= value) {
+                return (low - 1) * BLOCK + i;
+            }
+        }
+    }
+    if (low < blocks_.size()) {
+        return low * BLOCK;
+    }
+
+    for (size_t i = 0; i < tail_.size(); i++) {
+        if (tail_[i] >= value) {
+            return blocks_.size() * BLOCK + i;
+        }
+    }
+    return size();
+}
@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "CompressedIntegerVector.hpp"
+#include "ExtendableVector.hpp"
+using std::cout;
+using std::endl;
+
+int main() {
+    // Student IDs, sorted
+    CompressedIntegerVector studentIds;
+    studentIds.push_back(20240017);   // Adam
+    studentIds.push_back(20240112);   // Bob
+    studentIds.push_back(20240135);   // Carla
+    studentIds.push_back(20240398);   // Dolores
+
+    for (size_t i = 0; i < studentIds.size(); i++) {
+      cout << studentIds[i] << ' ';
+    }
+    cout << endl;
+    if (studentIds.lower_bound(20240120) != 2 || studentIds.at(3) != 20240398) {
+        std::cerr << "Compressed vector contents do not match expected\n";
+    }
+
+
+    // 50 million sorted 64 bit IDs, about 100 apart: compressed, and in a plain ExtendableVector
+    const size_t count = 50000000;
+    std::mt19937_64 random(42);
+    CompressedIntegerVector compressed;
+    ExtendableVector<uint64_t> plain(count);
+    uint64_t id = uint64_t(1) << 40;
+    for (size_t i = 0; i < count; i++) {
+        id += 1 + random() % 200;
+        compressed.push_back(id);
+        plain.push_back(id);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t plainSum = 0;
+    for (size_t i = 0; i < plain.size(); i++) {
+        plainSum += plain[i];
+    }
+    auto middle = std::chrono::steady_clock::now();
+    uint64_t compressedSum = 0;
+    compressed.forEach([&](uint64_t value) { compressedSum += value; });
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t probeSum = 0;
+    for (size_t i = 0; i < 1000000; i++) {
+        probeSum += compressed[random() % count];
+    }
+    auto probed = std::chrono::steady_clock::now();
+
+    cout << "Memory: ExtendableVector " << count * sizeof(uint64_t) / 1000000 << " MB, CompressedIntegerVector "
+         << compressed.memoryBytes() / 1000000 << " MB" << endl
+         << "Scan: ExtendableVector " << std::chrono::duration<double>(middle - start).count() << " s, CompressedIntegerVector "
+         << std::chrono::duration<double>(end - middle).count() << " s" << endl
+         << "1M random at(): " << std::chrono::duration<double>(probed - end).count() << " s" << endl;
+    if (plainSum != compressedSum || probeSum == 0) {
+        std::cerr << "Compressed scan does not match expected\n";
+    }
+}
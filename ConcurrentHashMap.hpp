@@ -0,0 +1,186 @@
+#pragma once
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t
+#include <functional>    // hash
+#include <mutex>         // unique_lock
+#include <shared_mutex>  // shared_mutex, shared_lock
+#include <stdexcept>
+
+#include "FlatHashMap.hpp"
+
+// A thread safe hash map built from independently locked FlatHashMap shards (lock striping).  A key's hash selects its shard,
+// so threads working on different shards never contend, and readers of the same shard share its reader/writer lock.  Each
+// shard is padded to its own cache line so that lock traffic on one shard does not invalidate its neighbours (false sharing).
+//
+// The interface mirrors BinarySearchTree.  As in FlatHashMap, inserting an existing key replaces its value.  search() returns
+// a copy of the value so no reference into a shard outlives the shard's lock.  Compile with -pthread.
+
+
+/*******************************************************************************
+**  Concurrent Hash Map Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentHashMap {
+  public:
+    explicit ConcurrentHashMap( size_t shardCount = DEFAULT_SHARDS );      // shardCount is rounded up to a power of two
+    ConcurrentHashMap             ( const ConcurrentHashMap & ) = delete;  // locks are not copyable;  copy the contents under a quiescent period instead
+    ConcurrentHashMap & operator= ( const ConcurrentHashMap & ) = delete;
+   ~ConcurrentHashMap             ();
+
+    // Queries  (all are safe to call concurrently from any number of threads)
+    Value  search  ( const Key & key )                       const;        // Returns the value associated with key. Throws invalid_argument if key not found
+    void   insert  ( const Key & key, const Value & value );               // Inserts key with value, or replaces the value if key is already present
+    void   remove  ( const Key & key );                                    // Removes key if present, otherwise does nothing
+    bool   contains( const Key & key )                       const;
+    size_t size    ()                                        const;        // A moment-in-time sum across shards;  may be stale under concurrent writers
+
+    void clear();
+
+
+  private:
+    static constexpr size_t DEFAULT_SHARDS = 64;
+    static constexpr size_t CACHE_LINE     = 64;
+
+    struct alignas(CACHE_LINE) Shard {
+      mutable std::shared_mutex           lock_;
+      FlatHashMap<Key, Value, Hash>       map_;
+    };
+
+    Shard * shards_     = nullptr;
+    size_t  shardCount_ = 0;                                               // always a power of two
+    Hash    hasher_;
+
+    // Helper functions
+    Shard & shardFor( const Key & key ) const;
+};
+
+
+/*******************************************************************************
+**  ConcurrentHashMap<Key, Value, Hash>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Shard selection
+////////////////////////////////////////////////////////////////////////////////
+// Uses the top bits of a differently mixed hash than FlatHashMap uses internally, so keys that share a shard are still spread
+// evenly across that shard's slots
+template <typename Key, typename Value, typename Hash>
+typename ConcurrentHashMap<Key, Value, Hash>::Shard & ConcurrentHashMap<Key, Value, Hash>::shardFor( const Key & key ) const
+{
+  uint64_t hash = static_cast<uint64_t>( hasher_( key ) );
+  hash ^= hash >> 31;
+  hash *= 0x9e3779b97f4a7c15ULL;
+  hash ^= hash >> 29;
+
+  return shards_[ ( hash >> 32 ) & ( shardCount_ - 1 ) ];
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+Value ConcurrentHashMap<Key, Value, Hash>::search( const Key & key ) const
+{
+  auto & shard = shardFor( key );
+  std::shared_lock<std::shared_mutex> guard( shard.lock_ );
+
+  return shard.map_.search( key );                                         // throws invalid_argument if not found, releasing the lock on the way out
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+bool ConcurrentHashMap<Key, Value, Hash>::contains( const Key & key ) const
+{
+  auto & shard = shardFor( key );
+  std::shared_lock<std::shared_mutex> guard( shard.lock_ );
+
+  return shard.map_.contains( key );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert / Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+void ConcurrentHashMap<Key, Value, Hash>::insert( const Key & key, const Value & value )
+{
+  auto & shard = shardFor( key );
+  std::unique_lock<std::shared_mutex> guard( shard.lock_ );
+
+  shard.map_.insert( key, value );
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+void ConcurrentHashMap<Key, Value, Hash>::remove( const Key & key )
+{
+  auto & shard = shardFor( key );
+  std::unique_lock<std::shared_mutex> guard( shard.lock_ );
+
+  shard.map_.remove( key );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+size_t ConcurrentHashMap<Key, Value, Hash>::size() const
+{
+  size_t total = 0;
+
+  for( size_t i = 0; i < shardCount_; ++i )
+  {
+    std::shared_lock<std::shared_mutex> guard( shards_[i].lock_ );
+    total += shards_[i].map_.size();
+  }
+
+  return total;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+ConcurrentHashMap<Key, Value, Hash>::ConcurrentHashMap( size_t shardCount )
+{
+  shardCount_ = 1;
+  while( shardCount_ < shardCount ) shardCount_ *= 2;
+
+  shards_ = new Shard[shardCount_];                                        // C++17 aligned new honors alignas(CACHE_LINE)
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+ConcurrentHashMap<Key, Value, Hash>::~ConcurrentHashMap()
+{ delete[] shards_; }
+
+
+
+
+// Shards are cleared one at a time;  a concurrent insert into an already cleared shard survives the call
+template <typename Key, typename Value, typename Hash>
+void ConcurrentHashMap<Key, Value, Hash>::clear()
+{
+  for( size_t i = 0; i < shardCount_; ++i )
+  {
+    std::unique_lock<std::shared_mutex> guard( shards_[i].lock_ );
+    shards_[i].map_.clear();
+  }
+}
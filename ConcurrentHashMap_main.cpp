@@ -0,0 +1,124 @@
+#include <algorithm>  // shuffle()
+#include <atomic>
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "ConcurrentHashMap.hpp"
+
+
+
+
+// The baseline being replaced:  one BinarySearchTree shared by every thread behind a single mutex
+template <typename Key, typename Value>
+class LockedBinarySearchTree {
+  public:
+    Value search( const Key & key )                       { std::lock_guard<std::mutex> guard( lock_ );  return tree_.search( key ); }
+    void  insert( const Key & key, const Value & value )  { std::lock_guard<std::mutex> guard( lock_ );  tree_.insert( key, value ); }
+    void  update( const Key & key, const Value & value )  { std::lock_guard<std::mutex> guard( lock_ );  tree_.remove( key );  tree_.insert( key, value ); }
+
+  private:
+    std::mutex                   lock_;
+    BinarySearchTree<Key, Value> tree_;
+};
+
+
+
+
+template <typename Key, typename Value>
+class ShardedMap : public ConcurrentHashMap<Key, Value> {
+  public:
+    void update( const Key & key, const Value & value )  { this->insert( key, value ); }   // insert replaces existing values
+};
+
+
+
+
+// Each thread performs operationsPerThread random operations on keys that are all present;  readPercent of them are searches
+// and the rest replace a value.  Reports total throughput in millions of operations per second.
+template <typename Map>
+double benchmark( unsigned threadCount, unsigned readPercent, unsigned keyCount, unsigned operationsPerThread )
+{
+  std::vector<unsigned> keys;
+  for( unsigned key = 0; key < keyCount; ++key )  keys.push_back( key );
+  std::shuffle( keys.begin(), keys.end(), std::mt19937( 131 ) );           // sorted inserts would degenerate the tree into a list
+
+  Map map;
+  for( auto key : keys )  map.insert( key, key );
+
+  std::atomic<unsigned long> checksum( 0 );                               // keeps the searches from being optimized away
+
+  auto worker = [&]( unsigned seed ) {
+    std::mt19937 generator( seed );
+    unsigned long sum = 0;
+
+    for( unsigned i = 0; i < operationsPerThread; ++i )
+    {
+      unsigned key = generator() % keyCount;
+
+      if( generator() % 100 < readPercent ) sum += map.search( key );
+      else                                  map.update( key, key );
+    }
+
+    checksum += sum;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for( unsigned t = 0; t < threadCount; ++t )  threads.emplace_back( worker, t + 1 );
+  for( auto & thread : threads )               thread.join();
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return threadCount * static_cast<double>( operationsPerThread ) / elapsed.count() / 1e6;
+}
+
+
+
+
+int main( int argc, char * argv[] ) {
+  ConcurrentHashMap<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  std::string myKey = "Ellen"; // find grade of one student
+  std::cout << "Grade of " << myKey << " is " << studentGrades.search(myKey) << '\n';
+
+  studentGrades.remove( "Ellen" );
+  if( studentGrades.contains( "Ellen" ) || studentGrades.size() != 4 ) std::cerr << "Remove did not match expected\n";
+
+
+
+  // Usage:  ConcurrentHashMap [maxThreads [operationsPerThread]]
+  unsigned maxThreads          = argc > 1 ? std::atoi( argv[1] ) : 64;
+  unsigned operationsPerThread = argc > 2 ? std::atoi( argv[2] ) : 100000;
+  unsigned keyCount            = 100000;
+
+  std::cout << "Throughput in millions of operations per second (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+
+  for( unsigned readPercent : { 50u, 90u, 99u, 100u } )
+  {
+    std::cout << readPercent << "% reads\n";
+
+    for( unsigned threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+      std::cout << "  " << threads << " threads:  "
+                << "LockedBinarySearchTree " << benchmark<LockedBinarySearchTree<unsigned, unsigned>>( threads, readPercent, keyCount, operationsPerThread )
+                << ",  ConcurrentHashMap "   << benchmark<ShardedMap            <unsigned, unsigned>>( threads, readPercent, keyCount, operationsPerThread )
+                << '\n';
+    }
+  }
+}
+
+
+
+template class ConcurrentHashMap<unsigned, float>;
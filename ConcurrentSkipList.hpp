@@ -0,0 +1,476 @@
+#pragma once
+#include <atomic>
+#include <cstddef>     // size_t
+#include <mutex>
+#include <new>         // placement new
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// A concurrent ordered map implemented as a "lazy" skip list (Herlihy, Lev, Luchangco, and Shavit, "A Simple Optimistic
+// Skiplist Algorithm", 2007).  Searches and range scans traverse the list without locks, and lock only each node they return
+// just long enough to copy its value, as insert() replaces values in place.  insert() and remove() find their position
+// without locking, then lock only the affected predecessors, validate that nothing changed underneath them, and retry if it
+// did.  A node is logically removed when marked_ is set and physically unlinked afterwards.
+//
+// Unlinked nodes cannot be deleted immediately because a concurrent reader may still be standing on them.  They are retired
+// to an epoch based reclamation scheme:  every operation announces the global epoch it started in, and a node retired in
+// epoch e is only deleted once the global epoch reaches e + 3, by which point every operation that could have seen it has
+// finished.
+//
+// The interface mirrors BinarySearchTree.  Duplicate keys are not allowed:  inserting an existing key replaces its value.
+// Keys are ordered with operator< and compared with operator==, just like BinarySearchTree.  Compile with -pthread.
+
+
+/*******************************************************************************
+**  Skip List Node Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+struct SkipListNode {
+  // The topLevel_ + 1 forward links live in the same allocation, directly after the node, so following a link touches one
+  // cache line instead of two.  Nodes must therefore be made and released with create() and destroy(), not new and delete.
+  static SkipListNode * create ( const Key & key, const Value & value, int topLevel );
+  static void           destroy( SkipListNode * node );
+
+  std::atomic<SkipListNode *> & next( int level );
+
+  Key                          key_;
+  Value                        value_;                                    // guarded by lock_ once the node is reachable
+  int                          topLevel_;
+  std::mutex                   lock_;
+  std::atomic<bool>            marked_      { false };                     // logically removed
+  std::atomic<bool>            fullyLinked_ { false };                     // linked at every level, now visible to searches
+
+  private:
+    SkipListNode( const Key & key, const Value & value, int topLevel );
+};
+
+
+/*******************************************************************************
+**  Concurrent Skip List Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class ConcurrentSkipList {
+  public:
+    ConcurrentSkipList             ();
+    ConcurrentSkipList             ( const ConcurrentSkipList & ) = delete;
+    ConcurrentSkipList & operator= ( const ConcurrentSkipList & ) = delete;
+   ~ConcurrentSkipList             ();                                     // not thread safe:  no other operations may be in progress
+
+    // Queries  (all are safe to call concurrently from any number of threads)
+    Value search  ( const Key & key )                       const;         // Returns the value associated with key. Throws invalid_argument if key not found
+    void  insert  ( const Key & key, const Value & value );                // Inserts key with value, or replaces the value if key is already present
+    void  remove  ( const Key & key );                                     // Removes key if present, otherwise does nothing
+    bool  contains( const Key & key )                       const;
+
+    template <typename Function>                                           // Calls visit( key, value ) in ascending key order for each key in [lo, hi].
+    void  scan    ( const Key & lo, const Key & hi, Function visit ) const; // Keys inserted or removed concurrently may or may not be visited
+
+
+  private:
+    using NodeType = SkipListNode<Key, Value>;
+
+    static constexpr int MAX_LEVEL = 32;
+
+    NodeType * head_;                                                      // sentinels:  head_ precedes every key, tail_ follows every key
+    NodeType * tail_;
+    std::atomic<int> levelInUse_ { 0 };                                    // highest level any node has been linked at;  find() starts here
+
+    // Epoch based reclamation
+    mutable std::atomic<unsigned>      globalEpoch_ { 0 };
+    mutable std::atomic<long>          active_[3]   { {0}, {0}, {0} };     // operations in progress, indexed by epoch % 3
+    std::mutex                         retireLock_;
+    std::vector<NodeType *>            retired_[3];                        // unlinked nodes, indexed by the retiring operation's epoch % 3
+
+    class EpochGuard {                                                     // Announces an operation for the lifetime of the guard
+      public:
+        explicit EpochGuard( const ConcurrentSkipList & list );
+       ~EpochGuard();
+        unsigned epoch() const { return epoch_; }
+      private:
+        const ConcurrentSkipList & list_;
+        unsigned                   epoch_;
+    };
+
+    // Helper functions
+    int  find      ( const Key & key, NodeType * preds[], NodeType * succs[] ) const;   // Returns the highest level key was found at, or -1
+    int  randomLevel()                                                          const;
+    void retire    ( NodeType * node, unsigned epoch );
+};
+
+
+/*******************************************************************************
+**  ConcurrentSkipList<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Find
+////////////////////////////////////////////////////////////////////////////////
+// Records, at every level, the last node before key (preds) and the first node at or after key (succs).  Takes no locks.
+template <typename Key, typename Value>
+int ConcurrentSkipList<Key, Value>::find( const Key & key, NodeType * preds[], NodeType * succs[] ) const
+{
+  int  levelFound = -1;
+  auto pred       = head_;
+  auto topLevel   = levelInUse_.load( std::memory_order_acquire );
+
+  for( int level = MAX_LEVEL - 1; level > topLevel; --level )              // levels no node has reached yet hold only the sentinels
+  {
+    preds[level] = head_;
+    succs[level] = tail_;
+  }
+
+  for( int level = topLevel; level >= 0; --level )
+  {
+    auto cur = pred->next( level ).load( std::memory_order_acquire );
+    while( cur != tail_  &&  cur->key_ < key )
+    {
+      pred = cur;
+      cur  = pred->next( level ).load( std::memory_order_acquire );
+    }
+
+    if( levelFound == -1  &&  cur != tail_  &&  cur->key_ == key ) levelFound = level;
+
+    preds[level] = pred;
+    succs[level] = cur;
+  }
+
+  return levelFound;
+}
+
+
+
+
+// Geometric distribution:  each level is half as likely as the one below it
+template <typename Key, typename Value>
+int ConcurrentSkipList<Key, Value>::randomLevel() const
+{
+  thread_local std::mt19937 generator( std::random_device{}() );
+
+  auto bits  = generator();
+  int  level = 0;
+  while( ( bits & 1u ) != 0  &&  level < MAX_LEVEL - 1 ) { ++level;  bits >>= 1; }
+
+  return level;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value ConcurrentSkipList<Key, Value>::search( const Key & key ) const
+{
+  EpochGuard guard( *this );
+  NodeType * preds[MAX_LEVEL], * succs[MAX_LEVEL];
+
+  auto level = find( key, preds, succs );
+  if( level != -1 )
+  {
+    auto node = succs[level];
+    if( node->fullyLinked_  &&  !node->marked_ )
+    {
+      std::lock_guard<std::mutex> valueGuard( node->lock_ );               // values are replaced in place, so copy under the node's lock
+      return node->value_;
+    }
+  }
+
+  throw std::invalid_argument( "Key not found" );
+}
+
+
+
+
+template <typename Key, typename Value>
+bool ConcurrentSkipList<Key, Value>::contains( const Key & key ) const
+{
+  EpochGuard guard( *this );
+  NodeType * preds[MAX_LEVEL], * succs[MAX_LEVEL];
+
+  auto level = find( key, preds, succs );
+  return level != -1  &&  succs[level]->fullyLinked_  &&  !succs[level]->marked_;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Range scan
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+template <typename Function>
+void ConcurrentSkipList<Key, Value>::scan( const Key & lo, const Key & hi, Function visit ) const
+{
+  EpochGuard guard( *this );
+  NodeType * preds[MAX_LEVEL], * succs[MAX_LEVEL];
+
+  find( lo, preds, succs );
+
+  for( auto cur = succs[0];  cur != tail_  &&  !( hi < cur->key_ );  cur = cur->next( 0 ).load() )
+  {
+    if( !cur->fullyLinked_  ||  cur->marked_ ) continue;
+
+    Value value;
+    {
+      std::lock_guard<std::mutex> valueGuard( cur->lock_ );
+      value = cur->value_;
+    }
+    visit( cur->key_, value );                                             // called without holding any lock
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::insert( const Key & key, const Value & value )
+{
+  EpochGuard guard( *this );
+  NodeType * preds[MAX_LEVEL], * succs[MAX_LEVEL];
+  int        topLevel = randomLevel();
+
+  // Raise the starting level before searching so this insert's find() records preds and succs at every level it will link
+  for( auto level = levelInUse_.load();  level < topLevel  &&  !levelInUse_.compare_exchange_weak( level, topLevel ); ) {}
+
+  while( true )
+  {
+    auto levelFound = find( key, preds, succs );
+
+    if( levelFound != -1 )                                                 // Key already present
+    {
+      auto node = succs[levelFound];
+      if( node->marked_ ) continue;                                        // being removed, retry once it is unlinked
+
+      while( !node->fullyLinked_ ) {}                                      // being inserted, wait until it is visible
+
+      std::lock_guard<std::mutex> nodeGuard( node->lock_ );
+      if( node->marked_ ) continue;
+
+      node->value_ = value;
+      return;
+    }
+
+    // Lock predecessors bottom up (a pred may repeat across levels, lock it once), then validate that each pred is still
+    // live and still points at succ.  On failure release everything and retry.
+    std::unique_lock<std::mutex> locks[MAX_LEVEL];
+    NodeType * previousPred = nullptr;
+    bool       valid        = true;
+
+    for( int level = 0; valid  &&  level <= topLevel; ++level )
+    {
+      auto pred = preds[level];
+      auto succ = succs[level];
+
+      if( pred != previousPred )
+      {
+        locks[level] = std::unique_lock<std::mutex>( pred->lock_ );
+        previousPred = pred;
+      }
+
+      valid = !pred->marked_  &&  ( succ == tail_  ||  !succ->marked_ )  &&  pred->next( level ).load() == succ;
+    }
+    if( !valid ) continue;
+
+    auto node = NodeType::create( key, value, topLevel );
+    for( int level = 0; level <= topLevel; ++level )  node ->next( level ).store( succs[level] );
+    for( int level = 0; level <= topLevel; ++level )  preds[level]->next( level ).store( node );
+
+    node->fullyLinked_ = true;                                             // linearization point
+    return;
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::remove( const Key & key )
+{
+  EpochGuard guard( *this );
+  NodeType * preds[MAX_LEVEL], * succs[MAX_LEVEL];
+  NodeType * victim   = nullptr;
+  int        topLevel = -1;
+
+  std::unique_lock<std::mutex> victimLock;
+
+  while( true )
+  {
+    auto levelFound = find( key, preds, succs );
+
+    if( victim == nullptr )
+    {
+      if( levelFound == -1 ) return;                                       // Not found
+
+      // Only a fully linked, unmarked node found at its own top level may be removed
+      auto candidate = succs[levelFound];
+      if( !candidate->fullyLinked_  ||  candidate->marked_  ||  candidate->topLevel_ != levelFound ) return;
+
+      victim     = candidate;
+      topLevel   = victim->topLevel_;
+      victimLock = std::unique_lock<std::mutex>( victim->lock_ );
+      if( victim->marked_ ) return;                                        // lost the race to another remove
+
+      victim->marked_ = true;                                              // linearization point:  logically removed
+    }
+
+    std::unique_lock<std::mutex> locks[MAX_LEVEL];
+    NodeType * previousPred = nullptr;
+    bool       valid        = true;
+
+    for( int level = 0; valid  &&  level <= topLevel; ++level )
+    {
+      auto pred = preds[level];
+
+      if( pred != previousPred )
+      {
+        locks[level] = std::unique_lock<std::mutex>( pred->lock_ );
+        previousPred = pred;
+      }
+
+      valid = !pred->marked_  &&  pred->next( level ).load() == victim;
+    }
+    if( !valid ) continue;
+
+    for( int level = topLevel; level >= 0; --level )  preds[level]->next( level ).store( victim->next( level ).load() );
+
+    victimLock.unlock();
+    retire( victim, guard.epoch() );
+    return;
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Epoch based reclamation
+////////////////////////////////////////////////////////////////////////////////
+// Operations only ever run in the current epoch or the one before it.  The epoch advances once nobody remains in the older
+// of the two, and at that point nodes retired three epochs ago can no longer be referenced by anyone.
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::retire( NodeType * node, unsigned epoch )
+{
+  std::lock_guard<std::mutex> guard( retireLock_ );
+  retired_[epoch % 3].push_back( node );
+
+  auto current = globalEpoch_.load();
+  if( active_[( current + 2 ) % 3].load() == 0 )                           // nobody left in epoch current - 1
+  {
+    globalEpoch_.store( current + 1 );
+
+    auto & reclaimable = retired_[( current + 1 ) % 3];                    // retired in epoch current - 2
+    for( auto retiredNode : reclaimable )  NodeType::destroy( retiredNode );
+    reclaimable.clear();
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::EpochGuard::EpochGuard( const ConcurrentSkipList & list )
+  : list_( list )
+{
+  while( true )
+  {
+    epoch_ = list_.globalEpoch_.load();
+    ++list_.active_[epoch_ % 3];
+
+    if( list_.globalEpoch_.load() == epoch_ ) return;                      // announced before the epoch moved on
+    --list_.active_[epoch_ % 3];
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::EpochGuard::~EpochGuard()
+{ --list_.active_[epoch_ % 3]; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::ConcurrentSkipList()
+{
+  head_ = NodeType::create( Key(), Value(), MAX_LEVEL - 1 );
+  tail_ = NodeType::create( Key(), Value(), MAX_LEVEL - 1 );
+
+  for( int level = 0; level < MAX_LEVEL; ++level )  head_->next( level ).store( tail_ );
+
+  head_->fullyLinked_ = true;
+  tail_->fullyLinked_ = true;
+}
+
+
+
+
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::~ConcurrentSkipList()
+{
+  auto cur = head_;
+  while( cur != tail_ )
+  {
+    auto next = cur->next( 0 ).load();
+    NodeType::destroy( cur );
+    cur = next;
+  }
+  NodeType::destroy( tail_ );
+
+  for( auto & list : retired_ )
+    for( auto node : list )  NodeType::destroy( node );
+}
+
+
+
+
+/*******************************************************************************
+**  SkipListNode<Key, Value>  Definitions
+*******************************************************************************/
+template <typename Key, typename Value>
+SkipListNode<Key, Value>::SkipListNode( const Key & key, const Value & value, int topLevel )
+  : key_( key ), value_( value ), topLevel_( topLevel )
+{}
+
+
+
+
+template <typename Key, typename Value>
+SkipListNode<Key, Value> * SkipListNode<Key, Value>::create( const Key & key, const Value & value, int topLevel )
+{
+  auto memory = ::operator new( sizeof( SkipListNode ) + ( topLevel + 1 ) * sizeof( std::atomic<SkipListNode *> ) );
+  auto node   = new( memory ) SkipListNode( key, value, topLevel );
+
+  for( int level = 0; level <= topLevel; ++level )  new( &node->next( level ) ) std::atomic<SkipListNode *>( nullptr );
+
+  return node;
+}
+
+
+
+
+template <typename Key, typename Value>
+void SkipListNode<Key, Value>::destroy( SkipListNode * node )
+{
+  node->~SkipListNode();                                                   // the atomic links are trivially destructible
+  ::operator delete( node );
+}
+
+
+
+
+template <typename Key, typename Value>
+std::atomic<SkipListNode<Key, Value> *> & SkipListNode<Key, Value>::next( int level )
+{ return reinterpret_cast<std::atomic<SkipListNode *> *>( this + 1 )[level]; }
@@ -0,0 +1,122 @@
+#include <algorithm>  // shuffle()
+#include <atomic>
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "ConcurrentSkipList.hpp"
+
+
+
+
+// The baseline being replaced:  one BinarySearchTree shared by every thread behind a single mutex
+template <typename Key, typename Value>
+class LockedBinarySearchTree {
+  public:
+    Value search( const Key & key )                       { std::lock_guard<std::mutex> guard( lock_ );  return tree_.search( key ); }
+    void  insert( const Key & key, const Value & value )  { std::lock_guard<std::mutex> guard( lock_ );  tree_.insert( key, value ); }
+    void  remove( const Key & key )                       { std::lock_guard<std::mutex> guard( lock_ );  tree_.remove( key ); }
+
+  private:
+    std::mutex                   lock_;
+    BinarySearchTree<Key, Value> tree_;
+};
+
+
+
+
+// Every key in [0, keyCount) starts out present.  Each write removes a key and inserts it again, so the key set (and the
+// searches that depend on it) stay valid while the structure churns.  Reports throughput in millions of operations per second.
+template <typename Map>
+double benchmark( unsigned threadCount, unsigned readPercent, unsigned keyCount, unsigned operationsPerThread )
+{
+  std::vector<unsigned> keys;
+  for( unsigned key = 0; key < keyCount; ++key )  keys.push_back( key );
+  std::shuffle( keys.begin(), keys.end(), std::mt19937( 131 ) );           // sorted inserts would degenerate the tree into a list
+
+  Map map;
+  for( auto key : keys )  map.insert( key, key );
+
+  std::atomic<unsigned long> checksum( 0 );                               // keeps the searches from being optimized away
+
+  // Each thread owns the keys congruent to its index so a key is never searched for while another thread has it removed
+  auto worker = [&]( unsigned index ) {
+    std::mt19937  generator( index + 1 );
+    unsigned long sum = 0;
+
+    for( unsigned i = 0; i < operationsPerThread; ++i )
+    {
+      unsigned key = generator() % keyCount;
+      key = key - key % threadCount + index;
+      if( key >= keyCount ) key = index;
+
+      if( generator() % 100 < readPercent )  sum += map.search( key );
+      else                                 { map.remove( key );  map.insert( key, i ); }
+    }
+
+    checksum += sum;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for( unsigned t = 0; t < threadCount; ++t )  threads.emplace_back( worker, t );
+  for( auto & thread : threads )               thread.join();
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return threadCount * static_cast<double>( operationsPerThread ) / elapsed.count() / 1e6;
+}
+
+
+
+
+int main( int argc, char * argv[] ) {
+  ConcurrentSkipList<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  std::string myKey = "Ellen"; // find grade of one student
+  std::cout << "Grade of " << myKey << " is " << studentGrades.search(myKey) << '\n';
+
+  studentGrades.scan( "D", "L", []( const std::string & key, double value ) {   // prints Ellen, Kevin, and Kumar in order
+    std::cout << "Key: \"" << key << "\",  Value: \"" << value << "\"\n";
+  } );
+
+  studentGrades.remove( "Ellen" );
+  if( studentGrades.contains( "Ellen" ) ) std::cerr << "Remove did not match expected\n";
+
+
+
+  // Usage:  ConcurrentSkipList [maxThreads [operationsPerThread]]
+  unsigned maxThreads          = argc > 1 ? std::atoi( argv[1] ) : 64;
+  unsigned operationsPerThread = argc > 2 ? std::atoi( argv[2] ) : 100000;
+  unsigned keyCount            = 100000;
+
+  std::cout << "Throughput in millions of operations per second (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+
+  for( unsigned readPercent : { 50u, 90u, 99u } )
+  {
+    std::cout << readPercent << "% reads\n";
+
+    for( unsigned threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+      std::cout << "  " << threads << " threads:  "
+                << "LockedBinarySearchTree " << benchmark<LockedBinarySearchTree<unsigned, unsigned>>( threads, readPercent, keyCount, operationsPerThread )
+                << ",  ConcurrentSkipList "  << benchmark<ConcurrentSkipList    <unsigned, unsigned>>( threads, readPercent, keyCount, operationsPerThread )
+                << '\n';
+    }
+  }
+}
+
+
+
+template class ConcurrentSkipList<unsigned, float>;
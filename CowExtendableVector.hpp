@@ -0,0 +1,263 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+// An ExtendableVector whose copies share one reference counted buffer (copy-on-write). Copying or
+// assigning only bumps the count, so passing a vector by value through read-only stages is O(1).
+// The first mutating call on a vector whose buffer is shared (set, push_back, insert, erase, at or
+// the non-const operator[]) first gives that vector a private copy of its elements; later calls run
+// as fast as ExtendableVector's until the buffer is shared again.
+//
+// Reads should go through a const vector (or const reference) to use the const at() and operator[],
+// which never copy. The non-const at() and operator[] hand out a reference through which the
+// element can be changed at any later time, so they also mark the buffer unshareable: copies of the
+// vector made after that get their own copy of the elements straight away, as with copy-on-write
+// strings, and the buffer becomes shareable again only once it is replaced by a growing push_back
+// or insert. Use set() to write without this. Like std::shared_ptr, separate vectors sharing a
+// buffer may be used from different threads; one vector may not be used by several threads at once.
+
+// Declaration
+template <typename T>
+class CowExtendableVector {
+private:
+    static const size_t DEFAULT_CAPACITY = 100;
+
+    struct Buffer {
+        std::atomic<size_t> references_;
+        size_t capacity_;
+        T* array_;
+        bool shareable_;   // false once a mutable reference into array_ has been handed out
+    };
+
+    size_t size_;     // each vector keeps its own size, so clear() never needs a private copy
+    Buffer* buffer_;
+
+public:
+    // Constructors
+    CowExtendableVector(size_t arraysize = DEFAULT_CAPACITY);
+    CowExtendableVector(const CowExtendableVector& input);   // shares input's buffer
+    CowExtendableVector& operator=(const CowExtendableVector& rhs); // Assignment operator, shares rhs's buffer
+    ~CowExtendableVector(); // destructor
+
+    // Getters / Setters
+    T& at(size_t index );
+    const T& at(size_t index ) const;
+    T& operator[](size_t index );
+    const T& operator[](size_t index ) const;
+    void push_back(const T& value );
+    void set(size_t index, const T& value );
+    void erase(size_t index );
+    void insert(size_t beforeIndex, const T& value);
+    size_t size() const;
+    bool empty() const;
+    void clear();
+    size_t use_count() const; // number of vectors sharing this vector's buffer
+
+private:
+    void reserve(size_t); // helper function to change capacity
+    void detach();        // helper function to make the buffer private before a write
+    void release();       // helper function to drop this vector's reference to its buffer
+    Buffer* copyBuffer(size_t capacity) const; // helper function to copy the elements into a new, private buffer
+    static Buffer* allocate(size_t capacity);
+};
+
+// Constructor with initial capacity argument
+template <typename T>
+CowExtendableVector<T>::CowExtendableVector(size_t arraysize) {
+    size_ = 0;
+    buffer_ = allocate(arraysize);
+}
+
+template <typename T>
+typename CowExtendableVector<T>::Buffer* CowExtendableVector<T>::allocate(size_t capacity) {
+    T* array = new T[capacity];
+    return new Buffer{ {1}, capacity, array, true };
+}
+
+template <typename T>
+size_t CowExtendableVector<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+bool CowExtendableVector<T>::empty() const {
+    return (size_ == 0);
+}
+
+template <typename T>
+void CowExtendableVector<T>::clear() {
+    size_ = 0;
+}
+
+template <typename T>
+size_t CowExtendableVector<T>::use_count() const {
+    return buffer_->references_.load(std::memory_order_relaxed);
+}
+
+// Getter, for writing: the element may be changed through the reference returned, so the buffer
+// may no longer be shared
+template <typename T>
+T& CowExtendableVector<T>::at(size_t index) {
+    if (index >= size_) {
+        throw std::range_error("index out of bounds");
+    }
+    detach();
+    buffer_->shareable_ = false;
+    return buffer_->array_[index];
+}
+
+// Getter, for reading
+template <typename T>
+const T& CowExtendableVector<T>::at(size_t index) const {
+    if (index >= size_) {
+        throw std::range_error("index out of bounds");
+    }
+    return buffer_->array_[index];
+}
+
+// Getter
+template <typename T>
+void CowExtendableVector<T>::push_back(const T &value) {
+    if (size_ >= buffer_->capacity_) // If at max capacity, double the capacity
+        reserve (2 * buffer_->capacity_ + 1);
+    detach();
+    buffer_->array_[size_] = value;
+    size_++;
+}
+
+// Overloaded Array-Access Operator, for writing
+template <typename T>
+T& CowExtendableVector<T>::operator[](size_t index) {
+    detach();
+    buffer_->shareable_ = false;
+    return buffer_->array_[index]; // Note: array bounds intentionally not checking
+}
+
+// Overloaded Array-Access Operator, for reading
+template <typename T>
+const T& CowExtendableVector<T>::operator[](size_t index) const {
+    return buffer_->array_[index]; // Note: array bounds intentionally not checking
+}
+
+// Setter
+template <typename T>
+void CowExtendableVector<T>::set(size_t index, const T &value) {
+    if (index >= size_) {
+        throw std::range_error("index out of bounds");
+    }
+    detach();             // no reference escapes, so the buffer stays shareable
+    buffer_->array_[index] = value;
+}
+
+// Removes element from position. Elements from higher positions are shifted back to fill gap.
+// Vector size decrements
+template <typename T>
+void CowExtendableVector<T>::erase(size_t index) {
+    if (index >= size_) {
+      throw std::range_error( "index out of bounds" );
+    }
+    detach();
+
+    // move elements to close the gap from the left and working right
+    T* array = buffer_->array_;
+    for (size_t j = index+1; j < size_; j++) // shift elements to the left
+        array[j-1] = array[j];
+    size_--;
+}
+
+// Copies x to element at position. Items at that position and higher are shifted over to make room. Vector size increments.
+template <typename T>
+void CowExtendableVector<T>::insert(size_t beforeIndex, const T &value) {
+    if ( beforeIndex >  size_ ) {
+      throw std::range_error( "index out of bounds" );
+    }
+
+    if (size_ >= buffer_->capacity_) // If at max capacity, double the capacity
+        reserve (2 * buffer_->capacity_ + 1);
+    detach();
+
+    // move elements to create space starting from the right and working left
+    T* array = buffer_->array_;
+    for (size_t j = size_; j > beforeIndex; j--)
+        array[j] = array[j-1]; // shift elements to the right
+
+    array[beforeIndex] = value; // put in empty slot
+    size_++;
+}
+
+// Growing always copies into a new buffer, which is private, so a shared buffer is not copied twice
+template <typename T>
+void CowExtendableVector<T>::reserve(size_t newCapacity) {
+    if (newCapacity > buffer_->capacity_) {
+        Buffer* newBuffer = copyBuffer(newCapacity);
+        release();
+        buffer_ = newBuffer;
+    }
+}
+
+// Only a buffer this vector holds the sole reference to may be written. Any other vector sharing it
+// holds a reference too, and could only add more by being copied, so a count of 1 stays 1.
+template <typename T>
+void CowExtendableVector<T>::detach() {
+    if (buffer_->references_.load(std::memory_order_acquire) == 1) {
+        return;
+    }
+
+    Buffer* newBuffer = copyBuffer(buffer_->capacity_);
+    release();
+    buffer_ = newBuffer;
+}
+
+template <typename T>
+typename CowExtendableVector<T>::Buffer* CowExtendableVector<T>::copyBuffer(size_t capacity) const {
+    Buffer* newBuffer = allocate(capacity);
+    // Copy values to new array
+    for (size_t i = 0; i < size_; i++) {
+        newBuffer->array_[i] = buffer_->array_[i];
+    }
+    return newBuffer;
+}
+
+template <typename T>
+void CowExtendableVector<T>::release() {
+    if (buffer_->references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete[] buffer_->array_;
+        delete buffer_;
+    }
+}
+
+// Copy Constructor: shares input's buffer unless a mutable reference into it may still be in use
+template <typename T>
+CowExtendableVector<T>::CowExtendableVector(const CowExtendableVector<T>& input) {
+    size_ = input.size_;
+    if (input.buffer_->shareable_) {
+        buffer_ = input.buffer_;
+        buffer_->references_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        buffer_ = input.copyBuffer(input.buffer_->capacity_);
+    }
+}
+
+// Overloaded Assignment Operator
+template <typename T>
+CowExtendableVector<T>& CowExtendableVector<T>::operator=(const CowExtendableVector<T>& rhs) {
+    if (buffer_ != rhs.buffer_) {
+        Buffer* newBuffer = rhs.buffer_;
+        if (newBuffer->shareable_) {
+            newBuffer->references_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            newBuffer = rhs.copyBuffer(newBuffer->capacity_);
+        }
+        release();
+        buffer_ = newBuffer;
+    }
+    size_ = rhs.size_;
+    return *this;
+}
+
+// Deconstructor
+template <typename T>
+CowExtendableVector<T>::~CowExtendableVector() {
+    release();
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "CowExtendableVector.hpp"
+#include "ExtendableVector.hpp"
+using std::cout;
+using std::string;
+using std::ostream;
+using std::endl;
+
+class Student {
+private:
+    string name_;
+    int numOfSemesters_;
+
+public:
+    Student() = default;
+
+    Student (string name, int nsem=1): name_(name), numOfSemesters_(nsem) {}
+
+    void updateNSemesters() {
+        numOfSemesters_++;
+    }
+
+    friend ostream& operator<<(ostream& os, const Student& student);
+};
+
+ostream& operator<<(ostream& os, const Student& student) {
+  os << "Name: " << student.name_;
+  os << ". No. of semesters= " << student.numOfSemesters_ << endl;
+  return os;
+}
+
+// Read-only pipeline stages: each takes its vector by value
+long long total(ExtendableVector<int> values) {
+    long long sum = 0;
+    for (size_t i = 0; i < values.size(); i += 1000) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+long long total(CowExtendableVector<int> values) {
+    const CowExtendableVector<int>& readOnly = values; // reads through a const reference never copy
+    long long sum = 0;
+    for (size_t i = 0; i < readOnly.size(); i += 1000) {
+        sum += readOnly[i];
+    }
+    return sum;
+}
+
+int main() {
+    CowExtendableVector<Student> studentVector; // capacity is not specified
+
+    Student s("Adam", 2);
+    studentVector.push_back(s);
+    studentVector.push_back(Student("Bob", 1));
+    studentVector.push_back(Student("Dolores", 3));
+
+    CowExtendableVector<Student> roster = studentVector; // shares the buffer: nothing copied
+    cout << "Vectors sharing the roster: " << roster.use_count() << endl;
+
+    // add student Carla between Bob and Dolores: studentVector gets its own copy first
+    studentVector.insert(2, Student("Carla"));
+    cout << "Vectors sharing the roster after an insert: " << roster.use_count() << endl;
+
+    // update Carla's record
+    studentVector[2].updateNSemesters();
+    for (size_t i = 0; i < studentVector.size(); i++) {
+      cout << studentVector[i];
+    }
+
+    const CowExtendableVector<Student>& original = roster;
+    for (size_t i = 0; i < original.size(); i++) {
+      cout << original[i];  // Adam, Bob, Dolores: unchanged
+    }
+    if (original.size() != 3 || studentVector.size() != 4) {
+        std::cerr << "Copy on write does not match expected\n";
+    }
+
+
+    // Fan out a large vector by value to read-only stages, deep copied and shared
+    const size_t count = 10000000;
+    const int stages = 20;
+    ExtendableVector<int> deep(count);
+    CowExtendableVector<int> shared(count);
+    for (size_t i = 0; i < count; i++) {
+        deep.push_back(static_cast<int>(i));
+        shared.push_back(static_cast<int>(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long deepSum = 0;
+    for (int stage = 0; stage < stages; stage++) {
+        deepSum += total(deep);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    long long sharedSum = 0;
+    for (int stage = 0; stage < stages; stage++) {
+        sharedSum += total(shared);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    cout << stages << " read-only stages over " << count << " elements: ExtendableVector "
+         << std::chrono::duration<double>(middle - start).count() << " s, CowExtendableVector "
+         << std::chrono::duration<double>(end - middle).count() << " s" << endl;
+    if (deepSum != sharedSum) {
+        std::cerr << "Stage totals do not match expected\n";
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <chrono>
+#include <cstddef>    // size_t
+#include <functional> // greater
+#include <queue>      // priority_queue
+#include <stdexcept>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+
+// A BinarySearchTree whose entries may carry an expiry time, e.g. session data.  An expired entry is a miss for search() and
+// contains() from the moment it expires, with no sweep needed:  each lookup checks the entry's own expiry against the time
+// it is given (now, by default).  The expired entries still take up memory until expire( now ) removes them, and it removes
+// exactly those:  a min-heap of ( expiry, key ) pairs hands them over earliest first, so expire() stops at the first entry
+// still live:  O(k log n) amortized for k expired entries, rather than a traversal of the whole tree.  The tree runs in
+// scapegoat mode, so session IDs or timestamps arriving in order still keep it O(log n) tall.
+//
+// Replacing or removing an entry leaves its old heap pair behind;  expire() recognizes such pairs, as their expiry no longer
+// matches the tree's, and drops them.  insert() and remove() rebuild the heap from the tree whenever it holds more than
+// 2 * size() + 64 pairs, so after each of them the heap is within that bound however inserts and removes are mixed.
+// Entries inserted with no expiry never enter the heap.  Keys are unique:  inserting an existing key replaces its value and
+// expiry.
+
+
+/*******************************************************************************
+**  Expiring Binary Search Tree Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value, typename Clock = std::chrono::steady_clock>
+class ExpiringBinarySearchTree {
+  public:
+    using TimePoint = typename Clock::time_point;
+
+    ExpiringBinarySearchTree();
+
+    // Queries
+    Value       search  ( const Key & key, TimePoint now = Clock::now() ) const;                  // Throws invalid_argument if key not found or expired
+    bool        contains( const Key & key, TimePoint now = Clock::now() ) const;
+    void        insert  ( const Key & key, const Value & value, TimePoint expiry = TimePoint::max() ); // Expires at expiry;  by default, never
+    void        remove  ( const Key & key );
+    std::size_t expire  ( TimePoint now = Clock::now() );                                         // Removes every entry expired by now.  Returns how many
+    std::size_t size    ()                                                 const;                // Entries, including expired ones not yet removed by expire()
+    void        clear   ();
+
+
+  private:
+    struct Entry {
+      Value     value_;
+      TimePoint expiry_;
+    };
+
+    struct Deadline {
+      TimePoint expiry_;
+      Key       key_;
+
+      bool operator>( const Deadline & rhs ) const { return expiry_ > rhs.expiry_; }
+    };
+
+    BinarySearchTree<Key, Entry>                                                    tree_;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;  // earliest expiry on top
+
+    // Helper functions
+    void rebuildDeadlines();                                               // Drops stale heap pairs
+};
+
+
+/*******************************************************************************
+**  ExpiringBinarySearchTree<Key, Value, Clock>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Constructor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Clock>
+ExpiringBinarySearchTree<Key, Value, Clock>::ExpiringBinarySearchTree()
+{ tree_.setScapegoatAlpha( 0.7 ); }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Queries
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Clock>
+Value ExpiringBinarySearchTree<Key, Value, Clock>::search( const Key & key, TimePoint now ) const
+{
+  auto entry = tree_.find( key );
+  if( entry == nullptr  ||  entry->expiry_ <= now ) throw std::invalid_argument( "Key not found" );
+
+  return entry->value_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Clock>
+bool ExpiringBinarySearchTree<Key, Value, Clock>::contains( const Key & key, TimePoint now ) const
+{
+  auto entry = tree_.find( key );
+  return entry != nullptr  &&  entry->expiry_ > now;
+}
+
+
+
+
+template <typename Key, typename Value, typename Clock>
+std::size_t ExpiringBinarySearchTree<Key, Value, Clock>::size() const
+{ return tree_.size(); }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert and remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Clock>
+void ExpiringBinarySearchTree<Key, Value, Clock>::insert( const Key & key, const Value & value, TimePoint expiry )
+{
+  tree_.remove( key );                                                     // any heap pair for the old entry goes stale
+  tree_.insert( key, Entry{ value, expiry } );
+
+  if( expiry != TimePoint::max() ) deadlines_.push( Deadline{ expiry, key } );
+  if( deadlines_.size() > 2 * tree_.size() + 64 ) rebuildDeadlines();
+}
+
+
+
+
+template <typename Key, typename Value, typename Clock>
+void ExpiringBinarySearchTree<Key, Value, Clock>::remove( const Key & key )
+{
+  tree_.remove( key );                                                     // any heap pair for the entry goes stale
+
+  if( deadlines_.size() > 2 * tree_.size() + 64 ) rebuildDeadlines();
+}
+
+
+
+
+template <typename Key, typename Value, typename Clock>
+void ExpiringBinarySearchTree<Key, Value, Clock>::clear()
+{
+  tree_.clear();
+  deadlines_ = {};
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Expiry
+////////////////////////////////////////////////////////////////////////////////
+// A pair whose key is gone, or whose key now carries a different expiry, was left behind by a remove or a replacement
+template <typename Key, typename Value, typename Clock>
+std::size_t ExpiringBinarySearchTree<Key, Value, Clock>::expire( TimePoint now )
+{
+  std::size_t expired = 0;
+
+  while( !deadlines_.empty()  &&  deadlines_.top().expiry_ <= now )
+  {
+    const auto & deadline = deadlines_.top();
+
+    auto entry = tree_.find( deadline.key_ );
+    if( entry != nullptr  &&  entry->expiry_ == deadline.expiry_ )
+    {
+      tree_.remove( deadline.key_ );
+      ++expired;
+    }
+
+    deadlines_.pop();
+  }
+
+  return expired;
+}
+
+
+
+
+template <typename Key, typename Value, typename Clock>
+void ExpiringBinarySearchTree<Key, Value, Clock>::rebuildDeadlines()
+{
+  std::vector<Deadline> live;
+  tree_.visitInorder( [&]( const Key & key, const Entry & entry ) {
+    if( entry.expiry_ != TimePoint::max() ) live.push_back( Deadline{ entry.expiry_, key } );
+  } );
+
+  deadlines_ = decltype( deadlines_ )( std::greater<Deadline>(), std::move( live ) );
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ExpiringBinarySearchTree.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  using Clock   = std::chrono::steady_clock;
+  using minutes = std::chrono::minutes;
+
+  auto start = Clock::now();                                               // times below are given explicitly, relative to start
+
+  ExpiringBinarySearchTree<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5,  start + minutes( 30 ));
+  studentGrades.insert("Ellen",   3.5,  start + minutes( 10 ));
+  studentGrades.insert("Chen",    2.5);                                    // never expires
+  studentGrades.insert("Kevin",   3.25, start + minutes( 10 ));
+  studentGrades.insert("Kumar",   3.05, start + minutes( 20 ));
+
+  studentGrades.insert( "Kevin", 3.5, start + minutes( 60 ) );             // extends Kevin's session
+
+  auto later = start + minutes( 25 );
+  std::cout << "Grade of Ricardo after 25 minutes:  " << studentGrades.search( "Ricardo", later ) << '\n';
+  if( studentGrades.contains( "Ellen", later )  ||  !studentGrades.contains( "Kevin", later ) ) std::cerr << "Expiry does not match expected\n";
+
+  auto expired = studentGrades.expire( later );                            // Ellen and Kumar
+  if( expired != 2  ||  studentGrades.size() != 3 ) std::cerr << "Expired entries do not match expected\n";
+
+
+
+  // Usage:  ExpiringBinarySearchTree [sessions]      Sessions expire spread over an hour;  a sweep runs every minute.
+  //                                                   Each sweep removes about 1/60th of the sessions.
+  std::size_t sessions = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+
+  std::mt19937                                 random( 42 );
+  ExpiringBinarySearchTree<unsigned, unsigned> store;
+  BinarySearchTree<unsigned, Clock::time_point> swept;                     // the same sessions, found by traversal instead
+
+  for( std::size_t i = 0; i < sessions; ++i )
+  {
+    auto key    = static_cast<unsigned>( random() );
+    auto expiry = start + std::chrono::seconds( random() % 3600 );
+    store.insert( key, 0, expiry );
+    swept.remove( key );                                                   // a repeated key replaces the session, as in store
+    swept.insert( key, expiry );
+  }
+
+  double heapSeconds = 0, sweepSeconds = 0;
+  for( int minute = 1; minute <= 60; ++minute )
+  {
+    auto now   = start + minutes( minute );
+    auto begin = Clock::now();
+    store.expire( now );
+    auto middle = Clock::now();
+
+    std::vector<unsigned> due;
+    swept.visitInorder( [&]( unsigned key, Clock::time_point expiry ) { if( expiry <= now ) due.push_back( key ); } );
+    for( auto key : due )  swept.remove( key );
+    auto end = Clock::now();
+
+    heapSeconds  += std::chrono::duration<double>( middle - begin ).count();
+    sweepSeconds += std::chrono::duration<double>( end - middle   ).count();
+    if( store.size() != swept.size() ) std::cerr << "Expired sessions do not match expected\n";
+  }
+
+  std::cout << "60 sweeps over " << sessions << " sessions:  expire() " << heapSeconds << " s,  traversal " << sweepSeconds << " s\n";
+  return 0;
+}
+
+
+
+
+// Explicit instantiation to ensure all functions are compiled
+template class ExpiringBinarySearchTree<unsigned, float>;
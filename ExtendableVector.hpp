@@ -1,10 +1,20 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
 
+// Alignment sets the byte boundary the element array starts on, e.g. 64 for a cache line or an
+// AVX-512 register, so vectorized loops over data() can use aligned loads. When a whole number of
+// elements fills one Alignment, capacity is also rounded up to a multiple of that number, so a
+// loop may run in full vector widths past size() up to capacity() with no scalar tail.
+
 // Declaration
-template <typename T>
+template <typename T, size_t Alignment = alignof(T)>
 class ExtendableVector {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+    static_assert(Alignment >= alignof(T), "Alignment must be at least alignof(T)");
+
 private:
     static const size_t DEFAULT_CAPACITY = 100;
     size_t size_;
@@ -26,40 +36,89 @@ public:
     void erase(size_t index );
     void insert(size_t beforeIndex, const T& value);
     size_t size();
+    size_t capacity();
     bool empty();
     void clear();
+    T* data(); // start of the element array, aligned to Alignment
 
 private:
     void reserve(size_t); // helper function to change capacity
+    static size_t padded(size_t capacity);              // capacity rounded up to whole Alignment blocks
+    static T* allocate(size_t capacity);                // aligned replacements for new T[] and delete[]
+    static void deallocate(T* array, size_t capacity);
 
 };
 
 // Constructor with initial capacity argument
-template <typename T>
-ExtendableVector<T>::ExtendableVector(size_t arraysize) {
+template <typename T, size_t Alignment>
+ExtendableVector<T, Alignment>::ExtendableVector(size_t arraysize) {
     size_ = 0;
-    capacity_ = arraysize;
-    array_ = new T[capacity_];
+    capacity_ = padded(arraysize);
+    array_ = allocate(capacity_);
+}
+
+template <typename T, size_t Alignment>
+size_t ExtendableVector<T, Alignment>::padded(size_t capacity) {
+    if (Alignment % sizeof(T) != 0) {
+        return capacity;
+    }
+    const size_t perBlock = Alignment / sizeof(T);
+    return (capacity + perBlock - 1) / perBlock * perBlock;
+}
+
+// Like new T[capacity], every element is default constructed
+template <typename T, size_t Alignment>
+T* ExtendableVector<T, Alignment>::allocate(size_t capacity) {
+    T* array = static_cast<T*>(::operator new[](capacity * sizeof(T), std::align_val_t(Alignment)));
+    size_t i = 0;
+    try {
+        for (; i < capacity; i++) {
+            new (array + i) T();
+        }
+    } catch (...) {
+        // and like new T[], a constructor that throws leaves nothing behind
+        deallocate(array, i);
+        throw;
+    }
+    return array;
+}
+
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::deallocate(T* array, size_t capacity) {
+    for (size_t i = 0; i < capacity; i++) {
+        array[i].~T();
+    }
+    ::operator delete[](array, std::align_val_t(Alignment));
+}
+
+template <typename T, size_t Alignment>
+size_t ExtendableVector<T, Alignment>::capacity() {
+    return capacity_;
+}
+
+template <typename T, size_t Alignment>
+T* ExtendableVector<T, Alignment>::data() {
+    return array_;
 }
 
-template <typename T>
-size_t ExtendableVector<T>::size() {
+template <typename T, size_t Alignment>
+size_t ExtendableVector<T, Alignment>::size() {
     return size_;
 }
 
-template <typename T>
-bool ExtendableVector<T>::empty() {
+template <typename T, size_t Alignment>
+bool ExtendableVector<T, Alignment>::empty() {
     return (size_ == 0);
 }
 
-template <typename T>
-void ExtendableVector<T>::clear() {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::clear() {
     size_ = 0;
 }
 
 // Getter
-template <typename T>
-T& ExtendableVector<T>::at(size_t index) {
+template <typename T, size_t Alignment>
+T& ExtendableVector<T, Alignment>::at(size_t index) {
     if (index >= size_) {
         throw std::range_error("index out of bounds");
     }
@@ -67,8 +126,8 @@ T& ExtendableVector<T>::at(size_t index) {
 }
 
 // Getter
-template <typename T>
-void ExtendableVector<T>::push_back(const T &value) {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::push_back(const T &value) {
     if (size_ >= capacity_) // If at max capacity, double the capacity
         reserve (2 * capacity_);
     array_[size_] = value;
@@ -76,21 +135,21 @@ void ExtendableVector<T>::push_back(const T &value) {
 }
 
 // Overloaded Array-Access Operator
-template <typename T>
-T& ExtendableVector<T>::operator[](size_t index) {
+template <typename T, size_t Alignment>
+T& ExtendableVector<T, Alignment>::operator[](size_t index) {
     return array_[index]; // Note: array bounds intentionally not checking
 }
 
 // Setter
-template <typename T>
-void ExtendableVector<T>::set(size_t index, const T &value) {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::set(size_t index, const T &value) {
     at( index ) = value;  // delegate to at() leveraging error checking
 }
 
 // Removes element from position. Elements from higher positions are shifted back to fill gap.
 // Vector size decrements
-template <typename T>
-void ExtendableVector<T>::erase(size_t index) {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::erase(size_t index) {
     if (index >= size_) {
       throw std::range_error( "index out of bounds" );
     }
@@ -102,8 +161,8 @@ void ExtendableVector<T>::erase(size_t index) {
 }
 
 // Copies x to element at position. Items at that position and higher are shifted over to make room. Vector size increments.
-template <typename T>
-void ExtendableVector<T>::insert(size_t beforeIndex, const T &value) {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::insert(size_t beforeIndex, const T &value) {
     if ( beforeIndex >  size_ ) {
       throw std::range_error( "index out of bounds" );
     }
@@ -119,39 +178,40 @@ void ExtendableVector<T>::insert(size_t beforeIndex, const T &value) {
     size_++;
 }
 
-template <typename T>
-void ExtendableVector<T>::reserve(size_t newCapacity) {
+template <typename T, size_t Alignment>
+void ExtendableVector<T, Alignment>::reserve(size_t newCapacity) {
     if (newCapacity > capacity_) {
-        T* newArray = new T[newCapacity];
+        newCapacity = padded(newCapacity);
+        T* newArray = allocate(newCapacity);
         // Copy values to new array
         for (size_t i = 0; i < size_; i++) {
             newArray[i] = array_[i];
         }
-        delete[] array_;
+        deallocate(array_, capacity_);
         array_ = newArray;
         capacity_ = newCapacity;
     }
 }
 
 // Copy Constructor
-template <typename T>
-ExtendableVector<T>::ExtendableVector(const ExtendableVector<T>& input) {
+template <typename T, size_t Alignment>
+ExtendableVector<T, Alignment>::ExtendableVector(const ExtendableVector<T, Alignment>& input) {
     size_ = input.size_;
     capacity_ = input.capacity_;
-    array_ = new T[capacity_];
+    array_ = allocate(capacity_);
     for (size_t i = 0; i < size_; i++) {
         array_[i] = input.array_[i];
     }
 }
 
 // Overloaded Assignment Operator
-template <typename T>
-ExtendableVector<T>& ExtendableVector<T>::operator=(const ExtendableVector<T>& rhs) {
+template <typename T, size_t Alignment>
+ExtendableVector<T, Alignment>& ExtendableVector<T, Alignment>::operator=(const ExtendableVector<T, Alignment>& rhs) {
     if (this != &rhs) {
-        delete[] array_;
+        deallocate(array_, capacity_);
         size_ = rhs.size_;
         capacity_ = rhs.capacity_;
-        array_ = new T[size_];
+        array_ = allocate(capacity_);
         for (size_t i = 0; i < size_; i++) {
             array_[i] = rhs.array_[i];
         }
@@ -160,7 +220,7 @@ ExtendableVector<T>& ExtendableVector<T>::operator=(const ExtendableVector<T>& r
 }
 
 // Deconstructor
-template <typename T>
-ExtendableVector<T>::~ExtendableVector() {
-    delete[] array_;
+template <typename T, size_t Alignment>
+ExtendableVector<T, Alignment>::~ExtendableVector() {
+    deallocate(array_, capacity_);
 }
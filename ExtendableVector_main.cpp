@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -57,4 +58,13 @@ int main() {
       cout << studentVector[i];
     }
 
+    // 64 byte aligned storage, e.g. for AVX-512 kernels over data(): 16 floats per aligned block
+    ExtendableVector<float, 64> samples(1000);
+    for (size_t i = 0; i < 1000; i++) {
+        samples.push_back(i * 0.5f);
+    }
+    if (reinterpret_cast<std::uintptr_t>(samples.data()) % 64 != 0 || samples.capacity() % 16 != 0) {
+        std::cerr << "Aligned storage does not match expected\n";
+    }
+
 }
@@ -1,10 +1,21 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
 
+// Alignment sets the byte boundary the element array starts on, e.g. 64 for a cache line or an
+// AVX-512 register, so vectorized loops over data() can use aligned loads. When a whole number of
+// elements fills one Alignment, the array is also allocated in whole blocks of that many elements,
+// so a loop may read full vector widths past the last element with no scalar tail. The capacity
+// available to push_back() and insert() stays exactly as constructed.
+
 // Declaration
-template <typename T>
+template <typename T, size_t Alignment = alignof(T)>
 class FixedVector {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+    static_assert(Alignment >= alignof(T), "Alignment must be at least alignof(T)");
+
 private:
     size_t size_; // number of elements in the data structure
     const size_t capacity_; // length of the array
@@ -26,37 +37,82 @@ public:
     size_t size();
     bool empty();
     void clear();
+    T* data(); // start of the element array, aligned to Alignment
 
     // Overloaded Operators
     FixedVector& operator=(const FixedVector& rhs);  //Copy assignment
+
+private:
+    static size_t padded(size_t capacity);              // capacity rounded up to whole Alignment blocks
+    static T* allocate(size_t capacity);                // aligned replacements for new T[] and delete[]
+    static void deallocate(T* array, size_t capacity);
 };
 
 // Implementation
 
 // Constructor with initial capacity argument
-template <typename T>
-FixedVector<T>::FixedVector(size_t arraysize) : size_(0), capacity_(arraysize) {
-    array_ = new T[capacity_];
+template <typename T, size_t Alignment>
+FixedVector<T, Alignment>::FixedVector(size_t arraysize) : size_(0), capacity_(arraysize) {
+    array_ = allocate(padded(capacity_));
+}
+
+template <typename T, size_t Alignment>
+size_t FixedVector<T, Alignment>::padded(size_t capacity) {
+    if (Alignment % sizeof(T) != 0) {
+        return capacity;
+    }
+    const size_t perBlock = Alignment / sizeof(T);
+    return (capacity + perBlock - 1) / perBlock * perBlock;
+}
+
+// Like new T[capacity], every element is default constructed
+template <typename T, size_t Alignment>
+T* FixedVector<T, Alignment>::allocate(size_t capacity) {
+    T* array = static_cast<T*>(::operator new[](capacity * sizeof(T), std::align_val_t(Alignment)));
+    size_t i = 0;
+    try {
+        for (; i < capacity; i++) {
+            new (array + i) T();
+        }
+    } catch (...) {
+        // and like new T[], a constructor that throws leaves nothing behind
+        deallocate(array, i);
+        throw;
+    }
+    return array;
+}
+
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::deallocate(T* array, size_t capacity) {
+    for (size_t i = 0; i < capacity; i++) {
+        array[i].~T();
+    }
+    ::operator delete[](array, std::align_val_t(Alignment));
+}
+
+template <typename T, size_t Alignment>
+T* FixedVector<T, Alignment>::data() {
+    return array_;
 }
 
-template <typename T>
-size_t FixedVector<T>::size() {
+template <typename T, size_t Alignment>
+size_t FixedVector<T, Alignment>::size() {
     return size_;
 }
 
-template <typename T>
-bool FixedVector<T>::empty() {
+template <typename T, size_t Alignment>
+bool FixedVector<T, Alignment>::empty() {
     return (size_ == 0);
 }
 
-template <typename T>
-void FixedVector<T>::clear() {
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::clear() {
     size_ = 0;
 }
 
 // Getter
-template <typename T>
-T& FixedVector<T>::at(size_t index) {
+template <typename T, size_t Alignment>
+T& FixedVector<T, Alignment>::at(size_t index) {
     if (index >= size_) {
         throw std::range_error( "index out of bounds" );
     }
@@ -65,27 +121,27 @@ T& FixedVector<T>::at(size_t index) {
 }
 
 // Getter
-template <typename T>
-void FixedVector<T>::push_back(const T& value) {
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::push_back(const T& value) {
     insert( size_, value ); // delegate to insert() leveraging error checking
 }
 
 // Overloaded Array-Access Operator
-template <typename T>
-T& FixedVector<T>::operator[](size_t index) {
+template <typename T, size_t Alignment>
+T& FixedVector<T, Alignment>::operator[](size_t index) {
     return array_[index];  // Note: intentionally not checking array bounds
 }
 
 // Setter
-template <typename T>
-void FixedVector<T>::set(size_t index, const T& value) {
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::set(size_t index, const T& value) {
     at( index ) = value;  // delegate to at() leveraging error checking
 }
 
 // Removes element from position. Elements from higher positions are shifted back to fill gap.
 // Vector size decrements
-template <typename T>
-void FixedVector<T>::erase(size_t index) {
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::erase(size_t index) {
     if (index >= size_) {
         throw std::range_error( "index out of bounds" );
     }
@@ -98,8 +154,8 @@ void FixedVector<T>::erase(size_t index) {
 }
 
 // Copies x to element at position. Items at that position and higher are shifted over to make room. Vector size increments.
-template <typename T>
-void FixedVector<T>::insert(size_t beforeIndex, const T &value) {
+template <typename T, size_t Alignment>
+void FixedVector<T, Alignment>::insert(size_t beforeIndex, const T &value) {
     if( size_ >= capacity_) {
         throw std::range_error("insufficient capacity to add another element");
     }
@@ -117,9 +173,9 @@ void FixedVector<T>::insert(size_t beforeIndex, const T &value) {
 }
 
 // Copy Constructor
-template <typename T>
-FixedVector<T>::FixedVector(const FixedVector<T>& input) : size_(input.size_), capacity_(input.capacity_) {
-    array_ = new T[capacity_];
+template <typename T, size_t Alignment>
+FixedVector<T, Alignment>::FixedVector(const FixedVector<T, Alignment>& input) : size_(input.size_), capacity_(input.capacity_) {
+    array_ = allocate(padded(capacity_));
 
     // Copy each element from the input vector to this vector
     for (size_t i = 0; i < size_; i++) {
@@ -128,8 +184,8 @@ FixedVector<T>::FixedVector(const FixedVector<T>& input) : size_(input.size_), c
 }
 
 // Overloaded Assignment Operator
-template <typename T>
-FixedVector<T>& FixedVector<T>::operator=(const FixedVector<T>& rhs) {
+template <typename T, size_t Alignment>
+FixedVector<T, Alignment>& FixedVector<T, Alignment>::operator=(const FixedVector<T, Alignment>& rhs) {
     if (this != &rhs) {
         // Being fixed size, the already allocated array can be reused
         // Capacity is not adjusted.  If capacity_ < rhs.capacity, then some
@@ -142,7 +198,7 @@ FixedVector<T>& FixedVector<T>::operator=(const FixedVector<T>& rhs) {
 }
 
 // Destructor
-template <typename T>
-FixedVector<T>::~FixedVector() {
-    delete[] array_;
+template <typename T, size_t Alignment>
+FixedVector<T, Alignment>::~FixedVector() {
+    deallocate(array_, padded(capacity_));
 }
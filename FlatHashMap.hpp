@@ -0,0 +1,401 @@
+#pragma once
+#include <cstddef>     // size_t
+#include <cstdint>     // uint64_t, uint32_t
+#include <functional>  // hash
+#include <iostream>
+#include <stdexcept>
+#include <utility>     // swap()
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define FLAT_HASH_MAP_USING_SSE2
+#endif
+
+// An open-addressing hash map in the style of Google's "Swiss table".  Each slot has a one byte control word that is either
+// EMPTY, DELETED, or (for a full slot) the low 7 bits of the key's hash (H2).  Control words are probed 16 at a time: a
+// whole group is loaded into one SSE2 register and compared against H2 in a single instruction, so most lookups touch one
+// cache line of control bytes and compare at most one key.  The upper hash bits (H1) pick the starting group.
+//
+// The interface mirrors BinarySearchTree so the two can be swapped for point lookups.  Unlike BinarySearchTree, duplicate
+// keys are not allowed:  inserting an existing key replaces its value.  There is no ordering, so there is no printInorder().
+// When SSE2 is not available, a portable byte-at-a-time loop computes the same group masks.
+
+
+/*******************************************************************************
+**  Flat Hash Map Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+  public:
+    FlatHashMap             () = default;
+    FlatHashMap             ( const FlatHashMap & original );              // performs a deep copy
+    FlatHashMap & operator= (       FlatHashMap   rhs      );              // performs a deep copy assignment  NOTE: INTENTIONALLY PASSED BY VALUE (delegates to copy constructor)
+   ~FlatHashMap             ();
+
+    // Queries
+    Value  search  ( const Key & key )                       const;        // Returns the value associated with key. Throws invalid_argument if key not found
+    void   insert  ( const Key & key, const Value & value );               // Inserts key with value, or replaces the value if key is already present
+    void   remove  ( const Key & key );                                    // Removes key if present, otherwise does nothing
+    bool   contains( const Key & key )                       const;
+    size_t size    ()                                        const;
+    bool   empty   ()                                        const;
+
+    void clear();                                                          // Returns the map to an empty state releasing all slots
+
+
+  private:
+    using ControlByte = signed char;
+
+    static constexpr ControlByte EMPTY      = -128;                        // 0b10000000
+    static constexpr ControlByte DELETED    = -2;                          // 0b11111110
+    static constexpr size_t      GROUP_WIDTH = 16;                         // control bytes examined per probe step
+    static constexpr size_t      MIN_CAPACITY = GROUP_WIDTH;
+
+    struct Slot {
+      Key   key_;
+      Value value_;
+    };
+
+    ControlByte * control_    = nullptr;                                   // capacity_ + GROUP_WIDTH bytes; the tail clones the first GROUP_WIDTH bytes so a group load never wraps
+    Slot        * slots_      = nullptr;
+    size_t        capacity_   = 0;                                         // always zero or a power of two
+    size_t        size_       = 0;
+    size_t        tombstones_ = 0;
+    Hash          hasher_;
+
+    // Helper functions
+    uint64_t hashOf    ( const Key & key )              const;
+    size_t   find      ( const Key & key, uint64_t hash ) const;           // Returns the slot index holding key, or capacity_ if not found
+    size_t   findFree  ( uint64_t hash )                 const;            // Returns the index of the first EMPTY or DELETED slot on hash's probe sequence
+    void     setControl( size_t index, ControlByte control );
+    void     rehash    ( size_t newCapacity );
+
+    static uint32_t matchByte( const ControlByte * group, ControlByte value );   // Bit i set if group[i] == value
+    static uint32_t matchEmpty( const ControlByte * group );                     // Bit i set if group[i] == EMPTY
+    static uint32_t matchFree ( const ControlByte * group );                     // Bit i set if group[i] is EMPTY or DELETED
+    static unsigned lowestBit ( uint32_t mask );
+};
+
+
+/*******************************************************************************
+**  FlatHashMap<Key, Value, Hash>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Group matching
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+uint32_t FlatHashMap<Key, Value, Hash>::matchByte( const ControlByte * group, ControlByte value )
+{
+  #if defined(FLAT_HASH_MAP_USING_SSE2)
+    auto ctrl = _mm_loadu_si128( reinterpret_cast<const __m128i *>( group ) );
+    return static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( ctrl, _mm_set1_epi8( value ) ) ) );
+
+  #else
+    uint32_t mask = 0;
+    for( size_t i = 0; i < GROUP_WIDTH; ++i )  if( group[i] == value ) mask |= 1u << i;
+    return mask;
+
+  #endif
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+uint32_t FlatHashMap<Key, Value, Hash>::matchEmpty( const ControlByte * group )
+{ return matchByte( group, EMPTY ); }
+
+
+
+
+// EMPTY and DELETED are the only control bytes with the sign bit set, so the sign bits alone identify free slots
+template <typename Key, typename Value, typename Hash>
+uint32_t FlatHashMap<Key, Value, Hash>::matchFree( const ControlByte * group )
+{
+  #if defined(FLAT_HASH_MAP_USING_SSE2)
+    auto ctrl = _mm_loadu_si128( reinterpret_cast<const __m128i *>( group ) );
+    return static_cast<uint32_t>( _mm_movemask_epi8( ctrl ) );
+
+  #else
+    uint32_t mask = 0;
+    for( size_t i = 0; i < GROUP_WIDTH; ++i )  if( group[i] < 0 ) mask |= 1u << i;
+    return mask;
+
+  #endif
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+unsigned FlatHashMap<Key, Value, Hash>::lowestBit( uint32_t mask )
+{
+  #if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>( __builtin_ctz( mask ) );
+
+  #else
+    unsigned bit = 0;
+    while( ( mask & 1u ) == 0 ) { mask >>= 1;  ++bit; }
+    return bit;
+
+  #endif
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Hashing and probing
+////////////////////////////////////////////////////////////////////////////////
+// std::hash is the identity function for integers on common library implementations, so mix the bits before splitting the
+// hash into H1 (probe start) and H2 (7 bit fingerprint stored in the control byte)
+template <typename Key, typename Value, typename Hash>
+uint64_t FlatHashMap<Key, Value, Hash>::hashOf( const Key & key ) const
+{
+  uint64_t hash = static_cast<uint64_t>( hasher_( key ) );
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+
+
+
+// Triangular probing over groups visits every group exactly once when the number of groups is a power of two
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::find( const Key & key, uint64_t hash ) const
+{
+  if( capacity_ == 0 ) return capacity_;
+
+  auto mask = capacity_ - 1;
+  auto h2   = static_cast<ControlByte>( hash & 0x7F );
+  auto pos  = static_cast<size_t>( hash >> 7 ) & mask;
+
+  for( size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH )
+  {
+    auto group = control_ + pos;
+
+    for( auto candidates = matchByte( group, h2 ); candidates != 0; candidates &= candidates - 1 )
+    {
+      auto index = ( pos + lowestBit( candidates ) ) & mask;
+      if( slots_[index].key_ == key ) return index;                       // Found
+    }
+
+    if( matchEmpty( group ) != 0 ) return capacity_;                       // An EMPTY slot ends the probe sequence:  not found
+
+    pos = ( pos + step ) & mask;
+  }
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::findFree( uint64_t hash ) const
+{
+  auto mask = capacity_ - 1;
+  auto pos  = static_cast<size_t>( hash >> 7 ) & mask;
+
+  for( size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH )
+  {
+    auto freeSlots = matchFree( control_ + pos );
+    if( freeSlots != 0 ) return ( pos + lowestBit( freeSlots ) ) & mask;
+
+    pos = ( pos + step ) & mask;
+  }
+}
+
+
+
+
+// Keeps the cloned tail bytes in sync with the first GROUP_WIDTH control bytes
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::setControl( size_t index, ControlByte control )
+{
+  control_[index] = control;
+  if( index < GROUP_WIDTH ) control_[capacity_ + index] = control;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+Value FlatHashMap<Key, Value, Hash>::search( const Key & key ) const
+{
+  auto index = find( key, hashOf( key ) );
+
+  if( index == capacity_ ) throw std::invalid_argument( "Key not found" );
+  return slots_[index].value_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+bool FlatHashMap<Key, Value, Hash>::contains( const Key & key ) const
+{ return find( key, hashOf( key ) ) != capacity_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::insert( const Key & key, const Value & value )
+{
+  auto hash  = hashOf( key );
+  auto index = find( key, hash );
+
+  if( index != capacity_ )                                                 // Already present, replace the value
+  {
+    slots_[index].value_ = value;
+    return;
+  }
+
+  // Keep the load factor (including tombstones) at or below 7/8 so probe sequences stay short and always reach an EMPTY slot
+  if( ( size_ + tombstones_ + 1 ) * 8 > capacity_ * 7 )
+  {
+    if( size_ * 2 + 2 <= capacity_ )  rehash( capacity_ );                 // Mostly tombstones:  clean up in place
+    else                               rehash( capacity_ == 0 ? MIN_CAPACITY : capacity_ * 2 );
+  }
+
+  index = findFree( hash );
+  if( control_[index] == DELETED ) --tombstones_;
+
+  setControl( index, static_cast<ControlByte>( hash & 0x7F ) );
+  slots_[index].key_   = key;
+  slots_[index].value_ = value;
+  ++size_;
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::rehash( size_t newCapacity )
+{
+  auto oldControl  = control_;
+  auto oldSlots    = slots_;
+  auto oldCapacity = capacity_;
+
+  control_    = new ControlByte[newCapacity + GROUP_WIDTH];
+  slots_      = new Slot[newCapacity];
+  capacity_   = newCapacity;
+  tombstones_ = 0;
+
+  for( size_t i = 0; i < capacity_ + GROUP_WIDTH; ++i )  control_[i] = EMPTY;
+
+  for( size_t i = 0; i < oldCapacity; ++i )
+  {
+    if( oldControl[i] < 0 ) continue;                                      // EMPTY or DELETED
+
+    auto index = findFree( hashOf( oldSlots[i].key_ ) );
+    setControl( index, oldControl[i] );                                    // H2 does not depend on capacity
+    std::swap( slots_[index], oldSlots[i] );
+  }
+
+  delete[] oldControl;
+  delete[] oldSlots;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+// The slot becomes a tombstone (DELETED) rather than EMPTY so that probe sequences passing through it are not cut short
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::remove( const Key & key )
+{
+  auto index = find( key, hashOf( key ) );
+  if( index == capacity_ ) return;
+
+  setControl( index, DELETED );
+  slots_[index] = Slot();                                                  // release resources held by the key and value now
+  --size_;
+  ++tombstones_;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::size() const
+{ return size_; }
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+bool FlatHashMap<Key, Value, Hash>::empty() const
+{ return size_ == 0; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash>
+FlatHashMap<Key, Value, Hash>::FlatHashMap( const FlatHashMap & original )
+  : capacity_( original.capacity_ ), size_( original.size_ ), tombstones_( original.tombstones_ ), hasher_( original.hasher_ )
+{
+  if( capacity_ == 0 ) return;
+
+  control_ = new ControlByte[capacity_ + GROUP_WIDTH];
+  slots_   = new Slot[capacity_];
+
+  for( size_t i = 0; i < capacity_ + GROUP_WIDTH; ++i )  control_[i] = original.control_[i];
+  for( size_t i = 0; i < capacity_;               ++i )  if( control_[i] >= 0 ) slots_[i] = original.slots_[i];
+}
+
+
+
+
+// Passing by value delegates copying the map to the copy constructor, keeping the "copy" knowledge
+// in one place.  (Copy and swap idiom)
+template <typename Key, typename Value, typename Hash>
+FlatHashMap<Key, Value, Hash> & FlatHashMap<Key, Value, Hash>::operator=( FlatHashMap rhs )
+{
+  std::swap( control_,    rhs.control_    );
+  std::swap( slots_,      rhs.slots_      );
+  std::swap( capacity_,   rhs.capacity_   );
+  std::swap( size_,       rhs.size_       );
+  std::swap( tombstones_, rhs.tombstones_ );
+  std::swap( hasher_,     rhs.hasher_     );
+
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+FlatHashMap<Key, Value, Hash>::~FlatHashMap()
+{ clear(); }
+
+
+
+
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::clear()
+{
+  delete[] control_;
+  delete[] slots_;
+
+  control_    = nullptr;
+  slots_      = nullptr;
+  capacity_   = 0;
+  size_       = 0;
+  tombstones_ = 0;
+}
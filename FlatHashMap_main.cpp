@@ -0,0 +1,88 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "FlatHashMap.hpp"
+
+
+
+
+// Times inserting and then looking up every key (in a different random order) for both containers.  Pass the largest power
+// of ten to measure as the first command line argument, for example "FlatHashMap 8" runs 10^3 through 10^8 entries.
+// Entries beyond 10^6 take a long time for the tree and need several GB of memory.
+template <typename Map>
+void benchmark( const char * name, const std::vector<std::string> & keys, const std::vector<std::string> & probes )
+{
+  using Clock = std::chrono::steady_clock;
+
+  double checksum = 0.0;
+  Map    map;
+
+  auto start = Clock::now();
+  for( std::size_t i = 0; i < keys.size(); ++i )  map.insert( keys[i], static_cast<double>( i ) );
+  auto middle = Clock::now();
+  for( const auto & key : probes )                checksum += map.search( key );
+  auto stop = Clock::now();
+
+  auto nsPer = [&]( Clock::duration elapsed ) { return std::chrono::duration<double, std::nano>( elapsed ).count() / keys.size(); };
+
+  std::cout << "  " << name
+            << ":  insert " << nsPer( middle - start ) << " ns/op,"
+            << "  search "  << nsPer( stop - middle ) << " ns/op"
+            << "  (checksum " << checksum << ")\n";
+}
+
+
+
+
+int main( int argc, char * argv[] ) {
+  FlatHashMap<std::string, double> studentGrades, gradeBook;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  gradeBook = studentGrades; // test assignment operator, copy constructor, and destructor
+
+  std::string myKey = "Ellen"; // find grade of one student
+  std::cout << "Grade of " << myKey << " is " << studentGrades.search(myKey) << '\n';
+
+  gradeBook.remove( "Ellen" );
+  if( gradeBook.contains( "Ellen" ) || gradeBook.size() != 4 ) std::cerr << "Remove did not match expected\n";
+  if( !studentGrades.contains( "Ellen" ) )                      std::cerr << "Copy is not independent of the original\n";
+
+  studentGrades.insert( "Chen", 4.0 );  // duplicate keys replace the value
+  if( studentGrades.search( "Chen" ) != 4.0 || studentGrades.size() != 5 ) std::cerr << "Replace did not match expected\n";
+
+
+
+  int maxExponent = argc > 1 ? std::atoi( argv[1] ) : 6;
+  std::mt19937_64 generator( 131 );
+
+  for( int exponent = 3; exponent <= maxExponent; ++exponent )
+  {
+    std::size_t count = 1;
+    for( int i = 0; i < exponent; ++i ) count *= 10;
+
+    std::vector<std::string> keys;
+    keys.reserve( count );
+    for( std::size_t i = 0; i < count; ++i )  keys.push_back( "student-" + std::to_string( generator() ) );
+
+    auto probes = keys;
+    std::shuffle( probes.begin(), probes.end(), generator );
+
+    std::cout << "10^" << exponent << " entries\n";
+    benchmark<BinarySearchTree<std::string, double>>( "BinarySearchTree", keys, probes );
+    benchmark<FlatHashMap     <std::string, double>>( "FlatHashMap     ", keys, probes );
+  }
+}
+
+
+
+template class FlatHashMap<unsigned, float>;
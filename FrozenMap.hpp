@@ -0,0 +1,177 @@
+#pragma once
+#include <array>
+#include <cstddef>    // size_t
+#include <stdexcept>
+
+// A read-only map built entirely at compile time.  Write the table as a literal list of { key, value } pairs, the same pairs
+// that would otherwise be passed to BinarySearchTree::insert() one by one at startup:
+//
+//   constexpr auto gradePoints = makeFrozenMap<std::string_view, double>( { { "A", 4.0 }, { "B", 3.0 }, { "C", 2.0 } } );
+//   static_assert( gradePoints.search( "B" ) == 3.0 );
+//
+// The compiler sorts the pairs (an insertion sort:  tables are small and this runs once, in the compiler) and lays the sorted
+// keys out in Eytzinger order, the order a breadth first walk of a perfectly balanced search tree would visit them:  the root
+// at position 1, and the children of position i at 2i and 2i + 1.  The table is then a balanced BST with no pointers at all,
+// stored in the program image, so startup does no work and the map needs no memory of its own.
+//
+// search() walks down by computing the child position as 2i + ( key_i < key ), with no branch on the comparison, and the
+// first levels of the tree share cache lines.  Keys need constexpr operator< and operator== (integers, enumerations,
+// std::string_view, ...), and duplicate keys are a compile error.  Everything also works at run time.
+
+
+/*******************************************************************************
+**  Frozen Map Entry Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+struct FrozenEntry {                                                       // std::pair's assignment is not constexpr until C++20
+  Key   key_;
+  Value value_;
+};
+
+
+/*******************************************************************************
+**  Frozen Map Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value, std::size_t N>
+class FrozenMap {
+  static_assert( N > 0, "A frozen map needs at least one entry" );
+
+  public:
+    using Entry = FrozenEntry<Key, Value>;
+
+    constexpr explicit FrozenMap( const Entry ( & entries )[N] );          // Throws invalid_argument (a compile error in a constant expression) on duplicate keys
+    constexpr explicit FrozenMap( const std::array<Entry, N> & entries );
+
+    // Queries
+    constexpr const Value & search  ( const Key & key ) const;             // Throws invalid_argument if key not found
+    constexpr const Value * find    ( const Key & key ) const;             // nullptr if key not found
+    constexpr bool          contains( const Key & key ) const;
+    constexpr std::size_t   size    ()                  const { return N; }
+
+
+  private:
+    Key   keys_  [N] = {};                                                 // Eytzinger order:  keys_[i - 1] holds position i
+    Value values_[N] = {};
+
+    // Helper functions
+    constexpr void        build      ( const Entry * entries );
+    constexpr void        layOut     ( const Entry * sorted, std::size_t & next, std::size_t position );
+    constexpr std::size_t lowerBound ( const Key & key ) const;            // position of the first key not less than key, or 0
+};
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr FrozenMap<Key, Value, N> makeFrozenMap( const FrozenEntry<Key, Value> ( & entries )[N] )
+{ return FrozenMap<Key, Value, N>( entries ); }
+
+
+/*******************************************************************************
+**  FrozenMap<Key, Value, N>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t N>
+constexpr FrozenMap<Key, Value, N>::FrozenMap( const Entry ( & entries )[N] )
+{ build( entries ); }
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr FrozenMap<Key, Value, N>::FrozenMap( const std::array<Entry, N> & entries )
+{ build( entries.data() ); }
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr void FrozenMap<Key, Value, N>::build( const Entry * entries )
+{
+  Entry sorted[N] = {};
+
+  for( std::size_t i = 0; i < N; ++i )                                     // insertion sort
+  {
+    auto        entry = entries[i];
+    std::size_t j     = i;
+
+    for( ; j > 0  &&  entry.key_ < sorted[j - 1].key_; --j )  sorted[j] = sorted[j - 1];
+    sorted[j] = entry;
+  }
+
+  for( std::size_t i = 1; i < N; ++i )
+    if( !( sorted[i - 1].key_ < sorted[i].key_ ) ) throw std::invalid_argument( "Duplicate key" );
+
+  std::size_t next = 0;
+  layOut( sorted, next, 1 );
+}
+
+
+
+
+// An in-order walk of the implicit tree hands out the sorted entries in order, so position 1 gets the median, and so on down
+template <typename Key, typename Value, std::size_t N>
+constexpr void FrozenMap<Key, Value, N>::layOut( const Entry * sorted, std::size_t & next, std::size_t position )
+{
+  if( position > N ) return;
+
+  layOut( sorted, next, 2 * position );
+  keys_  [position - 1] = sorted[next].key_;
+  values_[position - 1] = sorted[next].value_;
+  ++next;
+  layOut( sorted, next, 2 * position + 1 );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+// Descends until it falls off the bottom, going right (2i + 1) exactly when the key at i is too small.  The path taken is then
+// the binary number i:  its trailing 1 bits are the final run of right turns, and the node just above that run, where the
+// walk last turned left, holds the first key not less than the one searched for.  If the walk never turned left, i is all 1
+// bits and the key is larger than every key in the map.
+template <typename Key, typename Value, std::size_t N>
+constexpr std::size_t FrozenMap<Key, Value, N>::lowerBound( const Key & key ) const
+{
+  std::size_t position = 1;
+  while( position <= N )  position = 2 * position + ( keys_[position - 1] < key );
+
+  while( position & 1 )  position >>= 1;                                  // undo the final run of right turns ...
+  return position >> 1;                                                    // ... and the left turn before it
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr const Value * FrozenMap<Key, Value, N>::find( const Key & key ) const
+{
+  auto position = lowerBound( key );
+  if( position == 0  ||  !( keys_[position - 1] == key ) ) return nullptr;
+
+  return &values_[position - 1];
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr const Value & FrozenMap<Key, Value, N>::search( const Key & key ) const
+{
+  auto value = find( key );
+  if( value == nullptr ) throw std::invalid_argument( "Key not found" );
+
+  return *value;
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t N>
+constexpr bool FrozenMap<Key, Value, N>::contains( const Key & key ) const
+{ return find( key ) != nullptr; }
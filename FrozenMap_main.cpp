@@ -0,0 +1,92 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "FrozenMap.hpp"
+
+using namespace std::literals;
+
+
+
+
+// Built by the compiler:  nothing below runs at startup
+constexpr auto studentGrades = makeFrozenMap<std::string_view, double>( {
+  { "Ricardo", 2.5  },
+  { "Ellen",   3.5  },
+  { "Chen",    2.5  },
+  { "Kevin",   3.25 },
+  { "Kumar",   3.05 } } );
+
+static_assert( studentGrades.size()             == 5    );
+static_assert( studentGrades.search( "Kevin"sv ) == 3.25 );
+static_assert( !studentGrades.contains( "Mary"sv )       );
+// static_assert( studentGrades.search( "Mary"sv ) );    would not compile:  "Key not found" is thrown at compile time
+
+
+
+
+// 1023 keys (a perfect tree of height 10), scrambled so the compile-time sort has work to do
+constexpr std::size_t TABLE_SIZE = 1023;
+
+constexpr unsigned tableKey( std::size_t i ) { return static_cast<unsigned>( ( i * 2654435761u ) % 1000003u ); }
+
+constexpr auto table = FrozenMap<unsigned, unsigned, TABLE_SIZE>( [] {
+  std::array<FrozenEntry<unsigned, unsigned>, TABLE_SIZE> entries = {};
+  for( std::size_t i = 0; i < TABLE_SIZE; ++i )  entries[i] = { tableKey( i ), static_cast<unsigned>( i ) };
+  return entries;
+}() );
+
+static_assert( table.search( tableKey( 500 ) ) == 500 );
+
+
+
+
+int main() {
+  std::cout << "Grade of Ellen:  " << studentGrades.search( "Ellen" ) << '\n';
+
+  std::string_view name = "Chen";                                          // run time lookups work too
+  if( !studentGrades.contains( name )  ||  studentGrades.contains( "Chenn" ) ) std::cerr << "Frozen map contents do not match expected\n";
+
+
+
+  // Compare lookups with the same table loaded into a BinarySearchTree at startup
+  using Clock = std::chrono::steady_clock;
+
+  auto start = Clock::now();
+  BinarySearchTree<unsigned, unsigned> tree;
+  tree.setScapegoatAlpha( 0.7 );                                           // keep it balanced, as the frozen map is
+  for( std::size_t i = 0; i < TABLE_SIZE; ++i )  tree.insert( tableKey( i ), static_cast<unsigned>( i ) );
+  auto loaded = std::chrono::duration<double, std::micro>( Clock::now() - start ).count();
+
+  std::mt19937          random( 42 );
+  std::vector<unsigned> probes( 1 << 20 );
+  for( auto & probe : probes )  probe = random() % 2 ? tableKey( random() % TABLE_SIZE ) : random() % 1000003u;   // half hits, half misses
+
+  auto time = [&]( auto lookup ) {
+    std::size_t found = 0;
+    auto        begin = Clock::now();
+    for( auto probe : probes )  found += lookup( probe );
+    auto seconds = std::chrono::duration<double>( Clock::now() - begin ).count();
+    return std::make_pair( seconds * 1e9 / probes.size(), found );
+  };
+
+  auto frozen     = time( [&]( unsigned key ) { return table.contains( key ); } );
+  auto treeLookup = time( [&]( unsigned key ) { return tree.contains( key ); } );
+
+  std::cout << "\nLoading " << TABLE_SIZE << " keys at startup:  BinarySearchTree " << loaded << " us,  FrozenMap 0 us\n"
+            << "Lookup:  BinarySearchTree " << treeLookup.first << " ns,  FrozenMap " << frozen.first << " ns\n";
+
+  if( frozen.second != treeLookup.second ) std::cerr << "Frozen map and tree disagree\n";
+
+  return 0;
+}
+
+
+
+
+// Explicit instantiation to ensure all functions are compiled
+template class FrozenMap<unsigned, double, 4>;
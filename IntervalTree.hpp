@@ -0,0 +1,184 @@
+#pragma once
+#include <iostream>
+#include <limits>     // numeric_limits
+#include <stdexcept>
+#include <utility>    // pair
+#include <vector>
+
+#include "AugmentedBinarySearchTree.hpp"
+
+// An interval tree:  an AugmentedBinarySearchTree keyed by each interval's lo_ endpoint whose nodes cache the largest hi_
+// endpoint in their subtree.  A query skips any subtree whose largest hi_ falls before the query starts, and any right
+// subtree whose smallest lo_ falls after the query ends, so reporting k overlaps costs O(height + k * height) rather than a
+// scan of every interval, and O(log n + k) style behaviour when the tree is balanced.
+//
+// Intervals are closed:  [lo_, hi_] overlaps [lo, hi] when lo_ <= hi and lo <= hi_.  Duplicate intervals are allowed.
+
+
+/*******************************************************************************
+**  Interval Definition
+*******************************************************************************/
+template <typename Endpoint>
+struct Interval {
+  Endpoint lo_;
+  Endpoint hi_;
+};
+
+template <typename Endpoint>
+bool operator==( const Interval<Endpoint> & lhs, const Interval<Endpoint> & rhs )
+{ return lhs.lo_ == rhs.lo_  &&  lhs.hi_ == rhs.hi_; }
+
+template <typename Endpoint>
+std::ostream & operator<<( std::ostream & stream, const Interval<Endpoint> & interval )
+{ return stream << '[' << interval.lo_ << ", " << interval.hi_ << ']'; }
+
+
+/*******************************************************************************
+**  Interval Tree Payload and Augmentation
+*******************************************************************************/
+template <typename Endpoint, typename Value>
+struct IntervalPayload {                                                   // what the underlying tree stores as its value
+  Endpoint hi_;
+  Value    value_;
+};
+
+template <typename Endpoint, typename Value>
+struct MaxEndpointMonoid {
+  using Result = Endpoint;
+  static Result identity()                                                { return std::numeric_limits<Endpoint>::lowest(); }
+  static Result lift   ( const IntervalPayload<Endpoint, Value> & payload ) { return payload.hi_; }
+  static Result combine( const Result & left, const Result & right )        { return left < right ? right : left; }
+};
+
+
+/*******************************************************************************
+**  Interval Tree Abstract Data Type Definition (Duplicate intervals allowed)
+*******************************************************************************/
+template <typename Endpoint, typename Value>
+class IntervalTree : private AugmentedBinarySearchTree<Endpoint, IntervalPayload<Endpoint, Value>, MaxEndpointMonoid<Endpoint, Value>> {
+  using Base = AugmentedBinarySearchTree<Endpoint, IntervalPayload<Endpoint, Value>, MaxEndpointMonoid<Endpoint, Value>>;
+
+  public:
+    using Entry = std::pair<Interval<Endpoint>, Value>;
+
+    // Queries
+    void               insert     ( const Interval<Endpoint> & interval, const Value & value );   // Throws invalid_argument if interval.hi_ < interval.lo_
+    void               remove     ( const Interval<Endpoint> & interval );                        // Removes one interval equal to the one given, if any
+    std::vector<Entry> overlapping( const Endpoint & point )                 const;               // Every interval containing point, ordered by lo_
+    std::vector<Entry> overlapping( const Interval<Endpoint> & interval )    const;               // Every interval overlapping the one given, ordered by lo_
+    void               printInorder()                                         const;
+
+    using Base::getHeight;
+    using Base::clear;
+
+
+  private:
+    using typename Base::NodeType;
+
+    void overlapping( NodeType * node, const Interval<Endpoint> & query, std::vector<Entry> & results ) const;
+    void printInorder( NodeType * node )                                                           const;
+};
+
+
+/*******************************************************************************
+**  IntervalTree<Endpoint, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert / Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Endpoint, typename Value>
+void IntervalTree<Endpoint, Value>::insert( const Interval<Endpoint> & interval, const Value & value )
+{
+  if( interval.hi_ < interval.lo_ ) throw std::invalid_argument( "Interval ends before it starts" );
+
+  Base::insert( interval.lo_, IntervalPayload<Endpoint, Value>{ interval.hi_, value } );
+}
+
+
+
+
+// Nodes with equal lo_ always sit in the right subtree of one another, so the search continues right until hi_ matches too
+template <typename Endpoint, typename Value>
+void IntervalTree<Endpoint, Value>::remove( const Interval<Endpoint> & interval )
+{
+  auto cur = this->root_;
+
+  while( cur != nullptr )
+  {
+    if     ( interval.lo_ < cur->key_ )         cur = cur->left_;
+    else if( cur->key_ < interval.lo_ )         cur = cur->right_;
+    else if( cur->value_.hi_ == interval.hi_ )  break;                     // Found
+    else                                        cur = cur->right_;
+  }
+
+  if( cur == nullptr ) return;
+
+  Base::remove( cur );                                                     // refreshes the cached maximum endpoints
+  Base::removed( 1 );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Overlap queries
+////////////////////////////////////////////////////////////////////////////////
+template <typename Endpoint, typename Value>
+std::vector<typename IntervalTree<Endpoint, Value>::Entry> IntervalTree<Endpoint, Value>::overlapping( const Endpoint & point ) const
+{
+  return overlapping( Interval<Endpoint>{ point, point } );
+}
+
+
+
+
+template <typename Endpoint, typename Value>
+std::vector<typename IntervalTree<Endpoint, Value>::Entry> IntervalTree<Endpoint, Value>::overlapping( const Interval<Endpoint> & interval ) const
+{
+  std::vector<Entry> results;
+  overlapping( this->root_, interval, results );
+  return results;
+}
+
+
+
+
+template <typename Endpoint, typename Value>
+void IntervalTree<Endpoint, Value>::overlapping( NodeType * node, const Interval<Endpoint> & query, std::vector<Entry> & results ) const
+{
+  if( node == nullptr  ||  node->aggregate_ < query.lo_ ) return;          // everything below ends before the query starts
+
+  overlapping( node->left_, query, results );
+
+  if( query.hi_ < node->key_ ) return;                                     // this node and everything to its right start after the query ends
+
+  if( !( node->value_.hi_ < query.lo_ ) ) results.emplace_back( Interval<Endpoint>{ node->key_, node->value_.hi_ }, node->value_.value_ );
+
+  overlapping( node->right_, query, results );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Print
+////////////////////////////////////////////////////////////////////////////////
+template <typename Endpoint, typename Value>
+void IntervalTree<Endpoint, Value>::printInorder() const
+{
+  printInorder( this->root_ );
+}
+
+
+
+
+template <typename Endpoint, typename Value>
+void IntervalTree<Endpoint, Value>::printInorder( NodeType * node ) const
+{
+  if( node == nullptr ) return;
+
+  printInorder( node->left_ );
+  std::cout << "Interval: " << Interval<Endpoint>{ node->key_, node->value_.hi_ } << ",  Value: \"" << node->value_.value_ << "\"\n";
+  printInorder( node->right_ );
+}
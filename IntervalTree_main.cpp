@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+
+#include "IntervalTree.hpp"
+
+
+
+
+int main() {
+  // Room bookings, in minutes since midnight
+  IntervalTree<int, std::string> bookings;
+  bookings.insert( {  600,  675 }, "CPSC 131 lecture" );                   //  10:00 - 11:15
+  bookings.insert( {  540,  600 }, "Office hours" );                       //   9:00 - 10:00
+  bookings.insert( {  690,  765 }, "CPSC 131 lab" );                       //  11:30 - 12:45
+  bookings.insert( {  480, 1020 }, "Projector rental" );                   //   8:00 - 17:00
+  bookings.insert( {  780,  840 }, "Faculty meeting" );                    //  13:00 - 14:00
+
+  bookings.printInorder();
+
+  std::cout << "Booked at 10:00:\n";                                       // Projector rental, Office hours, CPSC 131 lecture
+  for( const auto & entry : bookings.overlapping( 600 ) )  std::cout << "  " << entry.first << ' ' << entry.second << '\n';
+
+  std::cout << "Booked between 11:20 and 13:10:\n";                        // Projector rental, CPSC 131 lab, Faculty meeting
+  for( const auto & entry : bookings.overlapping( Interval<int>{ 680, 790 } ) )  std::cout << "  " << entry.first << ' ' << entry.second << '\n';
+
+  bookings.remove( { 480, 1020 } );
+  if( bookings.overlapping( 1000 ).size() != 0 ) std::cerr << "Remove did not match expected\n";
+  if( bookings.overlapping( Interval<int>{ 0, 2000 } ).size() != 4 ) std::cerr << "Overlap count does not match expected\n";
+}
+
+
+
+template class IntervalTree<double, unsigned>;
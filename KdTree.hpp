@@ -0,0 +1,197 @@
+#pragma once
+#include <algorithm>  // nth_element()
+#include <array>
+#include <cstddef>    // size_t
+#include <limits>     // numeric_limits
+#include <stdexcept>
+#include <utility>    // pair
+#include <vector>
+
+// A k-d tree:  a binary search tree over points in Dimensions dimensions whose levels take turns comparing one coordinate
+// (x at the root, y below it, then z, ... and back to x).  Each subtree therefore covers an axis aligned box of space, and
+// nearest-neighbour and range queries skip every subtree whose box cannot hold an answer.
+//
+// The tree is built in one pass from all of its points by splitting at the median of the current coordinate, so it is
+// perfectly balanced (height floor(log2 n)).  Rather than allocating a Node per point, the points are reordered in place inside
+// one contiguous array:  the subtree covering array positions [first, last) has its root at the middle position, its left
+// subtree in the lower half and its right subtree in the upper half.  No child pointers are stored, and a query walks
+// memory that is laid out the same way the tree is.  To add points, build a new tree.
+
+
+/*******************************************************************************
+**  k-d Tree Abstract Data Type Definition (Duplicate points allowed)
+*******************************************************************************/
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+class KdTree {
+  public:
+    using Point = std::array<Coordinate, Dimensions>;
+    using Entry = std::pair<Point, Value>;
+
+    KdTree() = default;
+    explicit KdTree( std::vector<Entry> entries );                         // Bulk median build in O(n log n)
+
+    // Queries
+    const Entry &      nearest( const Point & target )               const;  // Closest point by Euclidean distance.  Throws length_error if the tree is empty
+    std::vector<Entry> range  ( const Point & lo, const Point & hi ) const;  // Every point inside the box lo <= p <= hi (each coordinate, inclusive)
+    std::size_t        size   ()                                     const;
+    bool               empty  ()                                     const;
+
+
+  private:
+    std::vector<Entry> entries_;                                           // the tree, in implicit median order
+
+    // Helper functions
+    void build  ( std::size_t first, std::size_t last, std::size_t axis );
+    void nearest( std::size_t first, std::size_t last, std::size_t axis, const Point & target, std::size_t & best, double & bestDistance ) const;
+    void range  ( std::size_t first, std::size_t last, std::size_t axis, const Point & lo, const Point & hi, std::vector<Entry> & results ) const;
+
+    static double      squaredDistance( const Point & a, const Point & b );
+    static std::size_t nextAxis       ( std::size_t axis ) { return axis + 1 == Dimensions ? 0 : axis + 1; }
+};
+
+
+/*******************************************************************************
+**  KdTree<Coordinate, Dimensions, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build
+////////////////////////////////////////////////////////////////////////////////
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+KdTree<Coordinate, Dimensions, Value>::KdTree( std::vector<Entry> entries )
+  : entries_( std::move( entries ) )
+{
+  build( 0, entries_.size(), 0 );
+}
+
+
+
+
+// nth_element places the median (by this level's coordinate) in the middle position with no larger coordinate before it and
+// no smaller one after it:  exactly the BST ordering property for this level.  Then each half is built the same way.
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+void KdTree<Coordinate, Dimensions, Value>::build( std::size_t first, std::size_t last, std::size_t axis )
+{
+  if( last - first < 2 ) return;
+
+  auto middle = first + ( last - first ) / 2;
+  std::nth_element( entries_.begin() + first, entries_.begin() + middle, entries_.begin() + last,
+                    [axis]( const Entry & a, const Entry & b ) { return a.first[axis] < b.first[axis]; } );
+
+  build( first,      middle, nextAxis( axis ) );
+  build( middle + 1, last,   nextAxis( axis ) );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Nearest neighbour
+////////////////////////////////////////////////////////////////////////////////
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+const typename KdTree<Coordinate, Dimensions, Value>::Entry & KdTree<Coordinate, Dimensions, Value>::nearest( const Point & target ) const
+{
+  if( entries_.empty() ) throw std::length_error( "Nearest point of an empty tree" );
+
+  std::size_t best         = 0;
+  double      bestDistance = std::numeric_limits<double>::infinity();
+  nearest( 0, entries_.size(), 0, target, best, bestDistance );
+
+  return entries_[best];
+}
+
+
+
+
+// Search the side of the splitting plane holding the target first;  the other side only needs searching if the plane itself
+// is closer than the best point found so far
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+void KdTree<Coordinate, Dimensions, Value>::nearest( std::size_t first, std::size_t last, std::size_t axis, const Point & target,
+                                                     std::size_t & best, double & bestDistance ) const
+{
+  if( first >= last ) return;
+
+  auto   middle   = first + ( last - first ) / 2;
+  auto & point    = entries_[middle].first;
+  auto   distance = squaredDistance( point, target );
+  if( distance < bestDistance ) { bestDistance = distance;  best = middle; }
+
+  double offset = static_cast<double>( target[axis] ) - static_cast<double>( point[axis] );
+
+  if( offset < 0 )
+  {
+    nearest( first, middle, nextAxis( axis ), target, best, bestDistance );
+    if( offset * offset < bestDistance ) nearest( middle + 1, last, nextAxis( axis ), target, best, bestDistance );
+  }
+  else
+  {
+    nearest( middle + 1, last, nextAxis( axis ), target, best, bestDistance );
+    if( offset * offset < bestDistance ) nearest( first, middle, nextAxis( axis ), target, best, bestDistance );
+  }
+}
+
+
+
+
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+double KdTree<Coordinate, Dimensions, Value>::squaredDistance( const Point & a, const Point & b )
+{
+  double sum = 0.0;
+  for( std::size_t i = 0; i < Dimensions; ++i )
+  {
+    double difference = static_cast<double>( a[i] ) - static_cast<double>( b[i] );
+    sum += difference * difference;
+  }
+  return sum;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Range
+////////////////////////////////////////////////////////////////////////////////
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+std::vector<typename KdTree<Coordinate, Dimensions, Value>::Entry> KdTree<Coordinate, Dimensions, Value>::range( const Point & lo, const Point & hi ) const
+{
+  std::vector<Entry> results;
+  range( 0, entries_.size(), 0, lo, hi, results );
+  return results;
+}
+
+
+
+
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+void KdTree<Coordinate, Dimensions, Value>::range( std::size_t first, std::size_t last, std::size_t axis, const Point & lo, const Point & hi,
+                                                   std::vector<Entry> & results ) const
+{
+  if( first >= last ) return;
+
+  auto   middle = first + ( last - first ) / 2;
+  auto & point  = entries_[middle].first;
+
+  bool inside = true;
+  for( std::size_t i = 0; i < Dimensions  &&  inside; ++i )  inside = !( point[i] < lo[i] )  &&  !( hi[i] < point[i] );
+  if( inside ) results.push_back( entries_[middle] );
+
+  if( !( point[axis] < lo[axis] ) ) range( first,      middle, nextAxis( axis ), lo, hi, results );   // left side holds coordinates <= point's
+  if( !( hi[axis] < point[axis] ) ) range( middle + 1, last,   nextAxis( axis ), lo, hi, results );   // right side holds coordinates >= point's
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+std::size_t KdTree<Coordinate, Dimensions, Value>::size() const
+{ return entries_.size(); }
+
+
+
+
+template <typename Coordinate, std::size_t Dimensions, typename Value>
+bool KdTree<Coordinate, Dimensions, Value>::empty() const
+{ return entries_.empty(); }
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "KdTree.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  // Campus map, (x, y) in meters from the main entrance
+  using CampusMap = KdTree<double, 2, std::string>;
+  CampusMap campus( {
+    { { 120.0,  40.0 }, "Computer Science" },
+    { {  60.0, 210.0 }, "Pollak Library" },
+    { { 250.0, 180.0 }, "Titan Student Union" },
+    { { 300.0,  20.0 }, "Engineering" },
+    { { 180.0, 300.0 }, "Kinesiology" },
+    { {  20.0,  90.0 }, "Humanities" }
+  } );
+
+  std::cout << "Closest to (200, 60):  " << campus.nearest( { 200.0, 60.0 } ).second << '\n';          // Computer Science
+
+  std::cout << "Within x 0..150, y 0..220:\n";                                                        // Computer Science, Pollak Library, Humanities
+  for( const auto & entry : campus.range( { 0.0, 0.0 }, { 150.0, 220.0 } ) )  std::cout << "  " << entry.second << '\n';
+
+
+
+  // Usage:  KdTree [points]      (e.g. 10000000 for 10M points)
+  std::size_t count   = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  std::size_t queries = 200;
+  using Clock = std::chrono::steady_clock;
+  using Cloud = KdTree<float, 3, unsigned>;
+
+  std::mt19937 generator( 131 );
+  std::uniform_real_distribution<float> coordinate( 0.0f, 1000.0f );
+
+  std::vector<Cloud::Entry> points( count );
+  for( std::size_t i = 0; i < count; ++i )  points[i] = { { coordinate( generator ), coordinate( generator ), coordinate( generator ) }, static_cast<unsigned>( i ) };
+
+  auto  start = Clock::now();
+  Cloud cloud( points );
+  std::chrono::duration<double, std::milli> buildTime = Clock::now() - start;
+  std::cout << count << " 3-D points:  build " << buildTime.count() << " ms\n";
+
+  // The approach being replaced:  scan every point
+  auto scanNearest = [&]( const Cloud::Point & target ) {
+    std::size_t best = 0;
+    double      bestDistance = 1e300;
+    for( std::size_t i = 0; i < points.size(); ++i )
+    {
+      double distance = 0.0;
+      for( std::size_t d = 0; d < 3; ++d )  distance += ( double( points[i].first[d] ) - target[d] ) * ( double( points[i].first[d] ) - target[d] );
+      if( distance < bestDistance ) { bestDistance = distance;  best = i; }
+    }
+    return points[best].second;
+  };
+
+  std::vector<Cloud::Point> targets( queries );
+  for( auto & target : targets )  target = { coordinate( generator ), coordinate( generator ), coordinate( generator ) };
+
+  std::vector<unsigned> treeAnswers( queries ), scanAnswers( queries );
+  start = Clock::now();
+  for( std::size_t i = 0; i < queries; ++i )  treeAnswers[i] = cloud.nearest( targets[i] ).second;
+  std::chrono::duration<double, std::micro> treeTime = Clock::now() - start;
+
+  start = Clock::now();
+  for( std::size_t i = 0; i < queries; ++i )  scanAnswers[i] = scanNearest( targets[i] );
+  std::chrono::duration<double, std::micro> scanTime = Clock::now() - start;
+
+  std::size_t mismatches = 0;
+  for( std::size_t i = 0; i < queries; ++i )  if( treeAnswers[i] != scanAnswers[i] ) ++mismatches;
+
+  std::cout << "  nearest:  KdTree " << treeTime.count() / queries << " us/query,  scan " << scanTime.count() / queries << " us/query\n";
+  if( mismatches != 0 ) std::cerr << mismatches << " nearest neighbours do not match the scan\n";
+
+  std::size_t found = 0;
+  start = Clock::now();
+  for( auto & target : targets )  found += cloud.range( target, { target[0] + 50.0f, target[1] + 50.0f, target[2] + 50.0f } ).size();
+  std::chrono::duration<double, std::micro> rangeTime = Clock::now() - start;
+  std::cout << "  range (50 m cube):  KdTree " << rangeTime.count() / queries << " us/query, " << found / queries << " points/query\n";
+}
+
+
+
+template class KdTree<int, 3, float>;
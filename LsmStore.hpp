@@ -0,0 +1,458 @@
+#pragma once
+#include <algorithm>           // lower_bound()
+#include <condition_variable>
+#include <cstddef>             // size_t
+#include <memory>              // shared_ptr, make_shared()
+#include <mutex>               // mutex, unique_lock, lock_guard
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "BlockedBloomFilter.hpp"
+
+// A log-structured merge (LSM) store.  Writes go to a small BinarySearchTree, the memtable, which stays shallow and cache
+// resident no matter how large the store grows (it runs in scapegoat mode, so even sorted write bursts keep it balanced).
+// When the memtable reaches memtableCapacity entries it is flushed, in order, into an immutable sorted run:  a pair of
+// sorted arrays searched by binary search, with a BlockedBloomFilter of the run's keys in front.
+//
+// Removes are writes too:  they store a tombstone, which hides any older value of the key in older runs.  A lookup checks
+// the memtable, then each run from newest to oldest, skipping any run whose filter rules the key out, and stops at the first
+// value or tombstone it finds.
+//
+// Runs are grouped into tiers by size (tier t holds runs of up to memtableCapacity * mergeFanIn^t entries).  Once mergeFanIn
+// runs share a tier, a background thread merges them into one run of the next tier, keeping the newest value of each key,
+// and dropping tombstones when nothing older remains beneath them.  So every entry is rewritten O(log n) times in total, and a
+// lookup checks O(mergeFanIn * log n) runs at most, nearly all of them in one filter probe each.  compact() merges everything
+// into a single run right away.
+//
+// All operations are safe to call concurrently.  Merges run outside the store's lock on immutable runs, and lookups search
+// runs through a shared snapshot of the run list, so neither waits on a merge.  Compile with -pthread.
+
+
+/*******************************************************************************
+**  LSM Store Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class LsmStore {
+  public:
+    explicit LsmStore( std::size_t memtableCapacity = 4096, std::size_t mergeFanIn = 4, double falsePositiveRate = 0.01 );
+    LsmStore             ( const LsmStore & ) = delete;                    // owns a thread;  copy the contents instead
+    LsmStore & operator= ( const LsmStore & ) = delete;
+   ~LsmStore             ();                                               // waits for a merge in progress to finish
+
+    // Queries
+    Value       search  ( const Key & key )                       const;   // Returns the newest value written for key. Throws invalid_argument if key not found or removed
+    bool        contains( const Key & key )                       const;
+    void        insert  ( const Key & key, const Value & value );          // Inserts key with value, or replaces the value if key is already present
+    void        remove  ( const Key & key );                               // Writes a tombstone for key
+
+    void        flush   ();                                                // Writes the memtable out as a run now
+    void        compact ();                                                // Flushes, then merges every run into one, dropping tombstones.  Waits for the result
+    std::size_t runCount()                                        const;
+
+
+  private:
+    struct Slot {                                                          // a write:  a value, or a tombstone
+      Value value_   = Value();
+      bool  deleted_ = false;
+    };
+
+    struct Run {
+      Run( std::size_t expectedKeys, double falsePositiveRate ) : filter_( expectedKeys, falsePositiveRate ) {}
+
+      std::vector<Key>        keys_;                                       // ascending, unique
+      std::vector<Slot>       slots_;                                      // slots_[i] is the write for keys_[i]
+      BlockedBloomFilter<Key> filter_;
+    };
+
+    using RunPointer = std::shared_ptr<const Run>;
+    using RunList    = std::vector<RunPointer>;                            // newest first
+
+    mutable std::mutex             lock_;                                  // guards everything below up to mergeLock_
+    BinarySearchTree<Key, Slot>    memtable_;
+    BlockedBloomFilter<Key>        memtableFilter_;                        // so the common memtable miss costs no exception
+    std::shared_ptr<const RunList> runs_;
+    std::condition_variable        mergeWanted_;
+    bool                           mergePending_ = false;
+    bool                           stopping_     = false;
+
+    std::mutex                     mergeLock_;                             // one merge at a time, background or compact()
+    std::thread                    merger_;
+
+    std::size_t memtableCapacity_;
+    std::size_t mergeFanIn_;
+    double      falsePositiveRate_;
+
+    // Helper functions
+    bool        find       ( const Key & key, Value & value )                                   const;  // false if absent or removed
+    void        write      ( const Key & key, const Slot & slot );
+    void        flushLocked();                                                                          // requires lock_
+    bool        mergeOnce  ();                                                                          // merges one full tier, if any
+    void        mergeLoop  ();
+    RunPointer  merge      ( const RunList & runs, std::size_t first, std::size_t last, bool dropTombstones ) const;
+    void        replaceRuns( const RunList & merged, std::size_t first, std::size_t last, RunPointer result );
+    std::size_t tierOf     ( const Run & run )                                                  const;
+
+    static const Slot * findInRun( const Run & run, const Key & key );
+};
+
+
+/*******************************************************************************
+**  LsmStore<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value LsmStore<Key, Value>::search( const Key & key ) const
+{
+  Value value;
+  if( !find( key, value ) ) throw std::invalid_argument( "Key not found" );
+
+  return value;
+}
+
+
+
+
+template <typename Key, typename Value>
+bool LsmStore<Key, Value>::contains( const Key & key ) const
+{
+  Value value;
+  return find( key, value );
+}
+
+
+
+
+template <typename Key, typename Value>
+bool LsmStore<Key, Value>::find( const Key & key, Value & value ) const
+{
+  std::shared_ptr<const RunList> runs;
+
+  {
+    std::lock_guard<std::mutex> guard( lock_ );
+
+    if( memtableFilter_.mayContain( key ) )
+    {
+      try
+      {
+        auto slot = memtable_.search( key );
+        if( slot.deleted_ ) return false;
+
+        value = slot.value_;
+        return true;
+      }
+      catch( const std::invalid_argument & ) {}                            // filter false positive
+    }
+
+    runs = runs_;                                                          // the runs are immutable:  search them unlocked
+  }
+
+  for( const auto & run : *runs )
+  {
+    auto slot = findInRun( *run, key );
+    if( slot == nullptr ) continue;
+    if( slot->deleted_  ) return false;
+
+    value = slot->value_;
+    return true;
+  }
+
+  return false;
+}
+
+
+
+
+template <typename Key, typename Value>
+const typename LsmStore<Key, Value>::Slot * LsmStore<Key, Value>::findInRun( const Run & run, const Key & key )
+{
+  if( !run.filter_.mayContain( key ) ) return nullptr;
+
+  auto position = std::lower_bound( run.keys_.begin(), run.keys_.end(), key );
+  if( position == run.keys_.end()  ||  !( *position == key ) ) return nullptr;
+
+  return &run.slots_[position - run.keys_.begin()];
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert / Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::insert( const Key & key, const Value & value )
+{
+  write( key, Slot{ value, false } );
+}
+
+
+
+
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::remove( const Key & key )
+{
+  write( key, Slot{ Value(), true } );
+}
+
+
+
+
+// The memtable allows duplicate keys, so a rewrite removes the key's previous write first
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::write( const Key & key, const Slot & slot )
+{
+  std::lock_guard<std::mutex> guard( lock_ );
+
+  if( memtableFilter_.mayContain( key ) ) memtable_.remove( key );
+  memtable_.insert( key, slot );
+  memtableFilter_.add( key );
+
+  if( memtable_.size() >= memtableCapacity_ ) flushLocked();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Flush
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::flush()
+{
+  std::lock_guard<std::mutex> guard( lock_ );
+  flushLocked();
+}
+
+
+
+
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::flushLocked()
+{
+  if( memtable_.size() == 0 ) return;
+
+  auto run = std::make_shared<Run>( memtable_.size(), falsePositiveRate_ );
+  run->keys_ .reserve( memtable_.size() );
+  run->slots_.reserve( memtable_.size() );
+
+  memtable_.visitInorder( [&]( const Key & key, const Slot & slot ) {
+    run->keys_ .push_back( key );
+    run->slots_.push_back( slot );
+    run->filter_.add( key );
+  } );
+
+  auto runs = std::make_shared<RunList>();                                 // copy on write:  readers keep the old list
+  runs->reserve( runs_->size() + 1 );
+  runs->push_back( std::move( run ) );
+  runs->insert( runs->end(), runs_->begin(), runs_->end() );
+  runs_ = std::move( runs );
+
+  memtable_.clear();
+  memtableFilter_.clear();
+
+  if( runs_->size() >= mergeFanIn_ )
+  {
+    mergePending_ = true;
+    mergeWanted_.notify_one();
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Merge
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+std::size_t LsmStore<Key, Value>::tierOf( const Run & run ) const
+{
+  std::size_t tier  = 0;
+  std::size_t limit = memtableCapacity_;
+
+  while( run.keys_.size() > limit ) { limit *= mergeFanIn_;  ++tier; }
+
+  return tier;
+}
+
+
+
+
+// Looks for mergeFanIn or more neighbouring runs in the same tier, merges them without holding lock_, and swaps the result in
+template <typename Key, typename Value>
+bool LsmStore<Key, Value>::mergeOnce()
+{
+  std::lock_guard<std::mutex> mergeGuard( mergeLock_ );
+
+  std::shared_ptr<const RunList> runs;
+  {
+    std::lock_guard<std::mutex> guard( lock_ );
+    runs = runs_;
+  }
+
+  for( std::size_t first = 0, last; first < runs->size(); first = last )
+  {
+    auto tier = tierOf( *( *runs )[first] );
+    for( last = first + 1;  last < runs->size()  &&  tierOf( *( *runs )[last] ) == tier;  ++last ) {}
+
+    if( last - first >= mergeFanIn_ )
+    {
+      replaceRuns( *runs, first, last, merge( *runs, first, last, last == runs->size() ) );
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+
+
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::compact()
+{
+  flush();
+
+  std::lock_guard<std::mutex> mergeGuard( mergeLock_ );
+
+  std::shared_ptr<const RunList> runs;
+  {
+    std::lock_guard<std::mutex> guard( lock_ );
+    runs = runs_;
+  }
+
+  if( !runs->empty() ) replaceRuns( *runs, 0, runs->size(), merge( *runs, 0, runs->size(), true ) );
+}
+
+
+
+
+// A k-way merge of runs [first, last).  k is small (about mergeFanIn), so the smallest key is found by looking at every run's
+// cursor rather than with a heap.  When several runs hold the smallest key, the newest (lowest index) one's write wins.
+template <typename Key, typename Value>
+typename LsmStore<Key, Value>::RunPointer LsmStore<Key, Value>::merge( const RunList & runs, std::size_t first, std::size_t last,
+                                                                       bool dropTombstones ) const
+{
+  std::size_t total = 0;
+  for( auto i = first; i < last; ++i )  total += runs[i]->keys_.size();
+
+  auto                     result = std::make_shared<Run>( total, falsePositiveRate_ );
+  std::vector<std::size_t> cursor( last - first, 0 );
+  result->keys_ .reserve( total );
+  result->slots_.reserve( total );
+
+  while( true )
+  {
+    std::size_t newest = last;                                             // run holding the smallest key, newest first
+    for( auto i = first; i < last; ++i )
+    {
+      if( cursor[i - first] == runs[i]->keys_.size() ) continue;
+
+      if( newest == last  ||  runs[i]->keys_[cursor[i - first]] < runs[newest]->keys_[cursor[newest - first]] ) newest = i;
+    }
+    if( newest == last ) break;                                            // every run consumed
+
+    const auto & key  = runs[newest]->keys_ [cursor[newest - first]];
+    const auto & slot = runs[newest]->slots_[cursor[newest - first]];
+
+    if( !( dropTombstones  &&  slot.deleted_ ) )
+    {
+      result->keys_ .push_back( key );
+      result->slots_.push_back( slot );
+      result->filter_.add( key );
+    }
+
+    for( auto i = last; i-- > newest; )                                    // step past key in every run holding it, newest last
+      if( cursor[i - first] < runs[i]->keys_.size()  &&  runs[i]->keys_[cursor[i - first]] == key ) ++cursor[i - first];
+  }
+
+  return result;
+}
+
+
+
+
+// Only flushes add runs, and only at the front, while merges (serialized by mergeLock_) are the only thing removing them.  So
+// the runs merged still sit in the current list at their old positions, shifted by however many runs were flushed since.
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::replaceRuns( const RunList & merged, std::size_t first, std::size_t last, RunPointer result )
+{
+  std::lock_guard<std::mutex> guard( lock_ );
+
+  auto shift = runs_->size() - merged.size();
+  auto runs  = std::make_shared<RunList>( runs_->begin(), runs_->begin() + shift + first );
+
+  if( !result->keys_.empty() ) runs->push_back( std::move( result ) );
+  runs->insert( runs->end(), runs_->begin() + shift + last, runs_->end() );
+
+  runs_ = std::move( runs );
+}
+
+
+
+
+template <typename Key, typename Value>
+void LsmStore<Key, Value>::mergeLoop()
+{
+  std::unique_lock<std::mutex> guard( lock_ );
+
+  while( true )
+  {
+    mergeWanted_.wait( guard, [this] { return mergePending_  ||  stopping_; } );
+    if( stopping_ ) return;
+    mergePending_ = false;
+
+    guard.unlock();
+    while( mergeOnce() ) {}                                                // one merge can fill the next tier up
+    guard.lock();
+  }
+}
+
+
+
+
+template <typename Key, typename Value>
+std::size_t LsmStore<Key, Value>::runCount() const
+{
+  std::lock_guard<std::mutex> guard( lock_ );
+  return runs_->size();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+LsmStore<Key, Value>::LsmStore( std::size_t memtableCapacity, std::size_t mergeFanIn, double falsePositiveRate )
+  : memtableFilter_   ( memtableCapacity, falsePositiveRate ),
+    runs_             ( std::make_shared<RunList>() ),
+    memtableCapacity_ ( memtableCapacity ),
+    mergeFanIn_       ( mergeFanIn ),
+    falsePositiveRate_( falsePositiveRate )
+{
+  if( memtableCapacity == 0  ||  mergeFanIn < 2 ) throw std::invalid_argument( "Memtable capacity must be positive and merge fan-in at least 2" );
+
+  memtable_.setScapegoatAlpha( 0.7 );
+  merger_ = std::thread( &LsmStore::mergeLoop, this );
+}
+
+
+
+
+template <typename Key, typename Value>
+LsmStore<Key, Value>::~LsmStore()
+{
+  {
+    std::lock_guard<std::mutex> guard( lock_ );
+    stopping_ = true;
+  }
+
+  mergeWanted_.notify_one();
+  merger_.join();
+}
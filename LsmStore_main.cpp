@@ -0,0 +1,104 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "LsmStore.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  LsmStore<std::string, double> studentGrades( 2 );                        // tiny memtable so the grades reach the runs
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  studentGrades.insert( "Chen", 3.0 );                                     // newer value shadows the flushed one
+  studentGrades.remove( "Ellen" );                                         // tombstone shadows the flushed value
+  std::cout << "Grade of Chen is " << studentGrades.search( "Chen" ) << ",  " << studentGrades.runCount() << " runs\n";
+
+  studentGrades.compact();
+  if( studentGrades.contains( "Ellen" )  ||  studentGrades.search( "Kumar" ) != 3.05  ||  studentGrades.runCount() != 1 ) std::cerr << "Store contents do not match expected\n";
+
+
+
+  // Usage:  LsmStore [keys]      A write burst of random keys, then lookups of which half miss
+  std::size_t count = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  using Clock = std::chrono::steady_clock;
+
+  std::mt19937 generator( 131 );
+  std::vector<unsigned> keys( 2 * count );
+  for( std::size_t i = 0; i < keys.size(); ++i )  keys[i] = static_cast<unsigned>( i );
+  std::shuffle( keys.begin(), keys.end(), generator );
+
+  std::vector<unsigned> probes( keys );                                    // first count keys are written, the rest never are
+  std::shuffle( probes.begin(), probes.end(), generator );
+
+  unsigned long long checksum = 0;
+  std::cout << count << " keys:\n";
+
+  {  // The approach being replaced:  every write walks the one big tree
+    BinarySearchTree<unsigned, unsigned> tree;
+
+    auto start = Clock::now();
+    for( std::size_t i = 0; i < count; ++i )  tree.insert( keys[i], keys[i] );
+    std::chrono::duration<double, std::nano> writeTime = Clock::now() - start;
+
+    start = Clock::now();
+    for( auto key : probes )
+    {
+      try                                   { checksum += tree.search( key ); }
+      catch( const std::invalid_argument & ) {}
+    }
+    std::chrono::duration<double, std::nano> readTime = Clock::now() - start;
+
+    std::cout << "  BinarySearchTree:  " << writeTime.count() / count << " ns/write,  " << readTime.count() / probes.size() << " ns/lookup\n";
+  }
+
+  {
+    LsmStore<unsigned, unsigned> store;
+
+    auto start = Clock::now();
+    for( std::size_t i = 0; i < count; ++i )  store.insert( keys[i], keys[i] );
+    std::chrono::duration<double, std::nano> writeTime = Clock::now() - start;
+    auto runs = store.runCount();
+
+    start = Clock::now();
+    for( auto key : probes )
+    {
+      try                                   { checksum -= store.search( key ); }
+      catch( const std::invalid_argument & ) {}
+    }
+    std::chrono::duration<double, std::nano> readTime = Clock::now() - start;
+
+    std::cout << "  LsmStore:          " << writeTime.count() / count << " ns/write,  " << readTime.count() / probes.size() << " ns/lookup  (" << runs << " runs)\n";
+
+    start = Clock::now();
+    store.compact();
+    std::chrono::duration<double, std::milli> compactTime = Clock::now() - start;
+
+    start = Clock::now();
+    for( auto key : probes )
+    {
+      try                                   { checksum += store.search( key ); }
+      catch( const std::invalid_argument & ) {}
+    }
+    readTime = Clock::now() - start;
+    std::cout << "    after compact() (" << compactTime.count() << " ms):  " << readTime.count() / probes.size() << " ns/lookup\n";
+  }
+
+  unsigned long long written = 0;                                          // the three lookup passes add, subtract, then add the written keys
+  for( std::size_t i = 0; i < count; ++i )  written += keys[i];
+  if( checksum != written ) std::cerr << "Lookups do not match\n";
+}
+
+
+
+template class LsmStore<unsigned, float>;
@@ -0,0 +1,290 @@
+#pragma once
+#include <atomic>
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t
+#include <memory>        // shared_ptr, make_shared(), atomic_load(), atomic_store()
+#include <mutex>         // mutex, lock_guard, unique_lock
+#include <set>           // multiset
+#include <shared_mutex>  // shared_mutex, shared_lock
+#include <stdexcept>
+#include <utility>       // move(), pair
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+
+// A multi-version (MVCC) map.  Every committed write is kept as a new version of its key, stamped with the commit's timestamp,
+// in a chain from newest to oldest version hanging off the key's BinarySearchTree node.  A Snapshot taken by beginRead()
+// remembers the timestamp of the latest commit and reads, for each key, the newest version no newer than that:  repeated
+// searches through one snapshot always agree with each other, whatever commits happen meanwhile.
+//
+// A Batch collects inserts and removes;  commit() applies the whole batch under one new timestamp, so no snapshot ever sees
+// part of a batch.  Removes are versions too (tombstones).  Versions that no open snapshot can see any more pile up until
+// collectGarbage() drops them, along with keys whose newest visible version is a tombstone.
+//
+// Versions never change once linked in, and a chain's head is swapped atomically, so a read holds the tree's reader/writer
+// latch (shared) only while it looks up the key's chain, and walks the chain with no lock at all.  Commits are serialized by
+// their own mutex and publish a batch by advancing lastCommit_ after its versions are linked.  Rewriting keys already in the
+// tree never takes the latch exclusively;  only adding new keys to the tree does, and collectGarbage() when it takes keys
+// out.  So readers never wait for a writer to prepare or finish a batch, and writers wait for readers only to add keys.
+// A Snapshot holds no lock between searches.  All operations are safe to call concurrently.  Compile with -pthread.
+
+
+/*******************************************************************************
+**  MVCC Map Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class MvccMap {
+  public:
+    using Timestamp = std::uint64_t;
+    class Snapshot;
+    class Batch;
+
+    MvccMap             () = default;
+    MvccMap             ( const MvccMap & ) = delete;                      // latches are not copyable
+    MvccMap & operator= ( const MvccMap & ) = delete;
+
+    // Queries
+    Snapshot    beginRead     ()                     const;                // A consistent view of every commit so far, until the Snapshot is destroyed
+    Value       search        ( const Key & key )    const;                // Latest committed value. Throws invalid_argument if key not found
+    Timestamp   commit        ( const Batch & batch );                     // Applies every write in batch atomically, in the order written.  Returns its timestamp
+    std::size_t collectGarbage();                                          // Drops versions no open snapshot can read.  Returns how many were dropped
+
+
+  private:
+    struct Version {
+      Timestamp                timestamp_;
+      bool                     deleted_;
+      Value                    value_;
+      std::shared_ptr<Version> older_;
+    };
+
+    struct VersionChain {                                                  // what the tree stores:  one per key, updated in place
+      std::shared_ptr<Version> newest_;
+    };
+
+    mutable std::shared_mutex                            latch_;           // guards tree_'s structure
+    BinarySearchTree<Key, std::shared_ptr<VersionChain>> tree_;
+    std::atomic<Timestamp>                               lastCommit_{ 0 };
+    std::mutex                                           commitLock_;      // one writer at a time:  commit() or collectGarbage()
+
+    mutable std::mutex                                   snapshotsLock_;
+    mutable std::multiset<Timestamp>                     snapshots_;       // timestamps of the open snapshots
+
+    // Helper functions
+    std::shared_ptr<Version> find( const Key & key, Timestamp timestamp ) const;   // nullptr if absent or removed at timestamp
+};
+
+
+/*******************************************************************************
+**  Snapshot and Batch Definitions
+*******************************************************************************/
+template <typename Key, typename Value>
+class MvccMap<Key, Value>::Snapshot {
+  public:
+    Snapshot            ( Snapshot && other ) : map_( other.map_ ), timestamp_( other.timestamp_ ) { other.map_ = nullptr; }
+    Snapshot            ( const Snapshot & ) = delete;
+    Snapshot & operator=( const Snapshot & ) = delete;
+   ~Snapshot();                                                            // lets collectGarbage() reclaim what only this snapshot could see
+
+    Value     search   ( const Key & key ) const;                          // Value as of the snapshot. Throws invalid_argument if key not found
+    bool      contains ( const Key & key ) const;
+    Timestamp timestamp()                  const { return timestamp_; }
+
+
+  private:
+    friend class MvccMap;
+    Snapshot( const MvccMap * map, Timestamp timestamp ) : map_( map ), timestamp_( timestamp ) {}
+
+    const MvccMap * map_;
+    Timestamp       timestamp_;
+};
+
+
+
+
+template <typename Key, typename Value>
+class MvccMap<Key, Value>::Batch {
+  public:
+    void        insert( const Key & key, const Value & value ) { writes_.push_back( { key, Slot{ false, value   } } ); }   // Inserts key, or replaces its value
+    void        remove( const Key & key )                      { writes_.push_back( { key, Slot{ true,  Value() } } ); }
+    std::size_t size  ()                                 const { return writes_.size(); }
+    void        clear ()                                       { writes_.clear(); }
+
+
+  private:
+    friend class MvccMap;
+
+    struct Slot {
+      bool  deleted_;
+      Value value_;
+    };
+
+    std::vector<std::pair<Key, Slot>> writes_;
+};
+
+
+/*******************************************************************************
+**  MvccMap<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reads
+////////////////////////////////////////////////////////////////////////////////
+// lastCommit_ is read while snapshotsLock_ is held, which collectGarbage() also holds while it picks the oldest timestamp still
+// readable:  either it sees this snapshot, or this snapshot's timestamp is at least the one it picked
+template <typename Key, typename Value>
+typename MvccMap<Key, Value>::Snapshot MvccMap<Key, Value>::beginRead() const
+{
+  std::lock_guard<std::mutex> guard( snapshotsLock_ );
+
+  auto timestamp = lastCommit_.load( std::memory_order_acquire );
+  snapshots_.insert( timestamp );
+  return Snapshot( this, timestamp );
+}
+
+
+
+
+template <typename Key, typename Value>
+MvccMap<Key, Value>::Snapshot::~Snapshot()
+{
+  if( map_ == nullptr ) return;                                            // moved from
+
+  std::lock_guard<std::mutex> guard( map_->snapshotsLock_ );
+  map_->snapshots_.erase( map_->snapshots_.find( timestamp_ ) );
+}
+
+
+
+
+template <typename Key, typename Value>
+Value MvccMap<Key, Value>::Snapshot::search( const Key & key ) const
+{
+  auto version = map_->find( key, timestamp_ );
+  if( version == nullptr ) throw std::invalid_argument( "Key not found" );
+
+  return version->value_;
+}
+
+
+
+
+template <typename Key, typename Value>
+bool MvccMap<Key, Value>::Snapshot::contains( const Key & key ) const
+{
+  return map_->find( key, timestamp_ ) != nullptr;
+}
+
+
+
+
+// Reads through a snapshot of its own, so that collectGarbage() knows to keep what it reads
+template <typename Key, typename Value>
+Value MvccMap<Key, Value>::search( const Key & key ) const
+{
+  return beginRead().search( key );
+}
+
+
+
+
+template <typename Key, typename Value>
+std::shared_ptr<typename MvccMap<Key, Value>::Version> MvccMap<Key, Value>::find( const Key & key, Timestamp timestamp ) const
+{
+  std::shared_ptr<VersionChain> chain;
+  {
+    std::shared_lock<std::shared_mutex> guard( latch_ );
+
+    if( !tree_.contains( key ) ) return nullptr;
+    chain = tree_.search( key );
+  }
+
+  auto version = std::atomic_load( &chain->newest_ );
+  while( version != nullptr  &&  version->timestamp_ > timestamp )  version = version->older_;   // skip commits after the snapshot
+
+  if( version == nullptr  ||  version->deleted_ ) return nullptr;
+  return version;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Commit
+////////////////////////////////////////////////////////////////////////////////
+// Each new version points at the chain's previous head before it replaces it, so a reader walking the chain sees either
+// the old head or the new one, and skips the new one until lastCommit_ reaches its timestamp
+template <typename Key, typename Value>
+typename MvccMap<Key, Value>::Timestamp MvccMap<Key, Value>::commit( const Batch & batch )
+{
+  std::lock_guard<std::mutex> commitGuard( commitLock_ );                  // the tree's structure only changes under this lock
+
+  auto timestamp = lastCommit_.load( std::memory_order_relaxed ) + 1;
+
+  for( const auto & write : batch.writes_ )
+  {
+    const auto & key  = write.first;
+    const auto & slot = write.second;
+
+    if( !tree_.contains( key ) )
+    {
+      if( slot.deleted_ ) continue;                                        // removing a key that was never there
+
+      std::unique_lock<std::shared_mutex> guard( latch_ );
+      tree_.insert( key, std::make_shared<VersionChain>() );
+    }
+
+    auto chain = tree_.search( key );
+    auto older = std::atomic_load( &chain->newest_ );
+    std::atomic_store( &chain->newest_, std::make_shared<Version>( Version{ timestamp, slot.deleted_, slot.value_, std::move( older ) } ) );
+  }
+
+  lastCommit_.store( timestamp, std::memory_order_release );
+  return timestamp;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Garbage collection
+////////////////////////////////////////////////////////////////////////////////
+// No snapshot reads older than the oldest open one (or, with none open, the latest commit).  In each chain, the newest version
+// at or before that timestamp is what the oldest reader sees;  everything behind it is unreachable and is cut off.  Readers
+// never look behind that version, so cutting needs no lock.  If that version is a tombstone at the head of its chain, every
+// reader sees the key as removed, and the key leaves the tree.
+template <typename Key, typename Value>
+std::size_t MvccMap<Key, Value>::collectGarbage()
+{
+  std::lock_guard<std::mutex> commitGuard( commitLock_ );
+
+  Timestamp oldest;
+  {
+    std::lock_guard<std::mutex> snapshotsGuard( snapshotsLock_ );
+    oldest = snapshots_.empty() ? lastCommit_.load( std::memory_order_acquire ) : *snapshots_.begin();
+  }
+
+  std::size_t      dropped = 0;
+  std::vector<Key> removedKeys;
+
+  tree_.visitInorder( [&]( const Key & key, const std::shared_ptr<VersionChain> & chain ) {
+    auto newest  = std::atomic_load( &chain->newest_ );
+    auto version = newest.get();
+    while( version != nullptr  &&  version->timestamp_ > oldest )  version = version->older_.get();
+    if( version == nullptr ) return;
+
+    for( auto older = version->older_.get(); older != nullptr; older = older->older_.get() )  ++dropped;
+    version->older_.reset();
+
+    if( version == newest.get()  &&  version->deleted_ ) removedKeys.push_back( key );
+  } );
+
+  if( !removedKeys.empty() )
+  {
+    std::unique_lock<std::shared_mutex> guard( latch_ );
+    for( const auto & key : removedKeys )  tree_.remove( key );
+    dropped += removedKeys.size();
+  }
+
+  return dropped;
+}
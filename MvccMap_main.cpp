@@ -0,0 +1,97 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MvccMap.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  MvccMap<std::string, double> studentGrades;
+  MvccMap<std::string, double>::Batch enrollment;
+  enrollment.insert("Ricardo", 2.5);
+  enrollment.insert("Ellen", 3.5);
+  enrollment.insert("Chen", 2.5);
+  enrollment.insert("Kevin", 3.25);
+  enrollment.insert("Kumar", 3.05);
+  studentGrades.commit( enrollment );
+
+  auto transcript = studentGrades.beginRead();                             // sees the grades as they were at this point
+
+  MvccMap<std::string, double>::Batch regrade;
+  regrade.insert( "Ellen", 3.75 );
+  regrade.remove( "Kumar" );
+  studentGrades.commit( regrade );
+
+  std::cout << "Grade of Ellen:  transcript " << transcript.search( "Ellen" ) << ",  latest " << studentGrades.search( "Ellen" ) << '\n';
+  if( !transcript.contains( "Kumar" )  ||  studentGrades.beginRead().contains( "Kumar" ) ) std::cerr << "Snapshot contents do not match expected\n";
+
+  std::cout << "Versions collected while the transcript is open:  " << studentGrades.collectGarbage() << '\n';    // 0
+  { auto closed = std::move( transcript ); }
+  std::cout << "Versions collected after it closes:  "              << studentGrades.collectGarbage() << '\n';    // 3:  Ellen's 3.5, and Kumar's grade and tombstone
+
+
+
+  // Usage:  MvccMap [readers]      Bank transfers commit in pairs while readers total every account through one snapshot.
+  //                                The total never changes, so any reader seeing a different one saw half a batch.
+  std::size_t readers  = argc > 1 ? std::atoi( argv[1] ) : 3;
+  std::size_t accounts = 1000;
+  auto        duration = std::chrono::seconds( 1 );
+
+  MvccMap<unsigned, long> bank;
+  {
+    MvccMap<unsigned, long>::Batch opening;
+    for( unsigned account = 0; account < accounts; ++account )  opening.insert( account, 100 );
+    bank.commit( opening );
+  }
+
+  std::atomic<bool>        done{ false };
+  std::atomic<std::size_t> audits{ 0 }, inconsistent{ 0 };
+  std::vector<std::thread> auditors;
+
+  for( std::size_t i = 0; i < readers; ++i )
+    auditors.emplace_back( [&] {
+      while( !done )
+      {
+        auto snapshot = bank.beginRead();
+        long total    = 0;
+        for( unsigned account = 0; account < accounts; ++account )  total += snapshot.search( account );
+
+        if( total != 100 * static_cast<long>( accounts ) ) ++inconsistent;
+        ++audits;
+      }
+    } );
+
+  std::mt19937 generator( 131 );
+  std::size_t  transfers = 0;
+  auto         start     = std::chrono::steady_clock::now();
+
+  while( std::chrono::steady_clock::now() - start < duration )
+  {
+    unsigned from = generator() % accounts, to = generator() % accounts;
+    if( from == to ) continue;
+
+    MvccMap<unsigned, long>::Batch transfer;
+    transfer.insert( from, bank.search( from ) - 5 );
+    transfer.insert( to,   bank.search( to   ) + 5 );
+    bank.commit( transfer );
+
+    if( ++transfers % 1000 == 0 ) bank.collectGarbage();
+  }
+
+  done = true;
+  for( auto & auditor : auditors )  auditor.join();
+
+  std::cout << readers << " auditors, 1 writer for 1 s:  " << transfers << " transfers committed,  " << audits << " full audits of " << accounts << " accounts\n";
+  if( inconsistent != 0 ) std::cerr << inconsistent << " audits saw a partial transfer\n";
+}
+
+
+
+template class MvccMap<unsigned, float>;
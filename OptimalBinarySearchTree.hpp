@@ -0,0 +1,249 @@
+#pragma once
+#include <algorithm>  // sort()
+#include <cstddef>    // size_t
+#include <cstdint>    // uint32_t
+#include <stdexcept>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+
+// Builds a BinarySearchTree shaped for known access frequencies rather than for insertion order.  Each key is added with
+// the weight (e.g. hit count from logs) of searches for it, and build() picks the shape minimizing the expected number of
+// nodes a search visits:  frequently searched keys end up near the root even when they sort at the ends.
+//
+// Up to exactLimit keys the shape is optimal, found by Knuth's dynamic program in O(n^2) time and memory.  Beyond that it is
+// Mehlhorn's approximation:  each subtree's root is the key that splits the subtree's weight most evenly, which costs
+// O(n log n) and stays within a few visits per search of optimal (both are close to the entropy of the access weights).
+//
+// The chosen shape is then produced by inserting the keys into an ordinary BinarySearchTree in preorder (each root before its
+// subtrees), so the result is a normal tree and later inserts and removes work as usual.  Keys must be unique.
+
+
+/*******************************************************************************
+**  Optimal Binary Search Tree Builder Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+class OptimalBinarySearchTreeBuilder {
+  public:
+    explicit OptimalBinarySearchTreeBuilder( std::size_t exactLimit = 1024 );
+
+    void                         add          ( const Key & key, const Value & value, double weight );  // Throws invalid_argument if weight is negative
+    BinarySearchTree<Key, Value> build        ();                                                       // Throws invalid_argument if a key was added twice
+    double                       expectedVisits()                                            const;     // Weighted average nodes visited per search in the last tree built
+    void                         clear        ();
+
+
+  private:
+    struct Entry {
+      Key    key_;
+      Value  value_;
+      double weight_;
+    };
+
+    struct Placement {                                                     // an entry's position in the chosen shape
+      std::size_t index_;
+      std::size_t depth_;
+    };
+
+    std::vector<Entry>  entries_;
+    std::vector<double> prefix_;                                           // prefix_[i] = total weight of entries_[0, i)
+    std::size_t         exactLimit_;
+    double              expectedVisits_ = 0.0;
+
+    // Helper functions
+    std::vector<Placement> knuthPreorder   () const;                       // Optimal shape, O(n^2)
+    std::vector<Placement> mehlhornPreorder() const;                       // Weight bisection shape, O(n log n)
+    std::size_t            weightMidpoint  ( std::size_t first, std::size_t last ) const;
+    double                 weight          ( std::size_t first, std::size_t last ) const { return prefix_[last] - prefix_[first]; }
+};
+
+
+/*******************************************************************************
+**  OptimalBinarySearchTreeBuilder<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Constructors, entries
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+OptimalBinarySearchTreeBuilder<Key, Value>::OptimalBinarySearchTreeBuilder( std::size_t exactLimit )
+  : exactLimit_( exactLimit )
+{}
+
+
+
+
+template <typename Key, typename Value>
+void OptimalBinarySearchTreeBuilder<Key, Value>::add( const Key & key, const Value & value, double weight )
+{
+  if( !( weight >= 0.0 ) ) throw std::invalid_argument( "Access weight must not be negative" );
+
+  entries_.push_back( { key, value, weight } );
+}
+
+
+
+
+template <typename Key, typename Value>
+void OptimalBinarySearchTreeBuilder<Key, Value>::clear()
+{
+  entries_.clear();
+  prefix_.clear();
+  expectedVisits_ = 0.0;
+}
+
+
+
+
+template <typename Key, typename Value>
+double OptimalBinarySearchTreeBuilder<Key, Value>::expectedVisits() const
+{ return expectedVisits_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+BinarySearchTree<Key, Value> OptimalBinarySearchTreeBuilder<Key, Value>::build()
+{
+  std::sort( entries_.begin(), entries_.end(), []( const Entry & a, const Entry & b ) { return a.key_ < b.key_; } );
+
+  for( std::size_t i = 1; i < entries_.size(); ++i )
+    if( !( entries_[i - 1].key_ < entries_[i].key_ ) ) throw std::invalid_argument( "Duplicate key" );
+
+  prefix_.assign( entries_.size() + 1, 0.0 );
+  for( std::size_t i = 0; i < entries_.size(); ++i )  prefix_[i + 1] = prefix_[i] + entries_[i].weight_;
+
+  auto order = entries_.size() <= exactLimit_ ? knuthPreorder() : mehlhornPreorder();
+
+  BinarySearchTree<Key, Value> tree;
+  double                       visits = 0.0;
+  for( const auto & placement : order )
+  {
+    const auto & entry = entries_[placement.index_];
+    tree.insert( entry.key_, entry.value_ );                               // preorder inserts reproduce the chosen shape exactly
+    visits += entry.weight_ * ( placement.depth_ + 1 );
+  }
+
+  auto total      = weight( 0, entries_.size() );
+  expectedVisits_ = total > 0.0 ? visits / total : 0.0;
+
+  return tree;
+}
+
+
+
+
+// Knuth's dynamic program over half open key ranges [i, j):  cost[i][j] is the least total weighted visits of any subtree
+// holding exactly those keys, which is the range's own weight (every search in it visits the subtree's root) plus the best
+// cost[i][r] + cost[r+1][j] over roots r.  Knuth showed the best root never moves left as the range grows, so r need only run
+// from root[i][j-1] to root[i+1][j], making the whole table O(n^2) rather than O(n^3).
+template <typename Key, typename Value>
+std::vector<typename OptimalBinarySearchTreeBuilder<Key, Value>::Placement> OptimalBinarySearchTreeBuilder<Key, Value>::knuthPreorder() const
+{
+  auto n     = entries_.size();
+  auto width = n + 1;
+
+  std::vector<double>        cost( width * width, 0.0 );
+  std::vector<std::uint32_t> root( width * width, 0 );
+
+  for( std::size_t i = 0; i < n; ++i )
+  {
+    cost[i * width + i + 1] = entries_[i].weight_;
+    root[i * width + i + 1] = static_cast<std::uint32_t>( i );
+  }
+
+  for( std::size_t length = 2; length <= n; ++length )
+  {
+    for( std::size_t i = 0, j = length; j <= n; ++i, ++j )
+    {
+      auto   bestRoot = root[i * width + j - 1];
+      double bestCost = cost[i * width + bestRoot] + cost[( bestRoot + 1 ) * width + j];
+
+      for( std::size_t r = bestRoot + 1; r <= root[( i + 1 ) * width + j]; ++r )
+      {
+        double candidate = cost[i * width + r] + cost[( r + 1 ) * width + j];
+        if( candidate < bestCost ) { bestCost = candidate;  bestRoot = static_cast<std::uint32_t>( r ); }
+      }
+
+      cost[i * width + j] = bestCost + weight( i, j );
+      root[i * width + j] = bestRoot;
+    }
+  }
+
+  // Walk the root table in preorder with an explicit stack (an optimal tree for skewed weights can be as deep as it is wide)
+  struct Range { std::size_t first_, last_, depth_; };
+
+  std::vector<Placement> order;
+  std::vector<Range>     pending{ { 0, n, 0 } };
+  order.reserve( n );
+
+  while( !pending.empty() )
+  {
+    auto range = pending.back();
+    pending.pop_back();
+    if( range.first_ >= range.last_ ) continue;
+
+    std::size_t r = root[range.first_ * width + range.last_];
+    order.push_back( { r, range.depth_ } );
+    pending.push_back( { r + 1,        range.last_, range.depth_ + 1 } );  // right subtree after ...
+    pending.push_back( { range.first_, r,           range.depth_ + 1 } );  // ... the left
+  }
+
+  return order;
+}
+
+
+
+
+template <typename Key, typename Value>
+std::vector<typename OptimalBinarySearchTreeBuilder<Key, Value>::Placement> OptimalBinarySearchTreeBuilder<Key, Value>::mehlhornPreorder() const
+{
+  struct Range { std::size_t first_, last_, depth_; };
+
+  std::vector<Placement> order;
+  std::vector<Range>     pending{ { 0, entries_.size(), 0 } };
+  order.reserve( entries_.size() );
+
+  while( !pending.empty() )
+  {
+    auto range = pending.back();
+    pending.pop_back();
+    if( range.first_ >= range.last_ ) continue;
+
+    auto r = weightMidpoint( range.first_, range.last_ );
+    order.push_back( { r, range.depth_ } );
+    pending.push_back( { r + 1,        range.last_, range.depth_ + 1 } );
+    pending.push_back( { range.first_, r,           range.depth_ + 1 } );
+  }
+
+  return order;
+}
+
+
+
+
+// The root r of [first, last) that best balances weight( first, r ) against weight( r + 1, last ).  Their difference,
+// prefix_[r] + prefix_[r+1] - prefix_[first] - prefix_[last], never decreases as r grows, so binary search for where it
+// changes sign and take whichever neighbour is closer to zero.  Ranges with no weight at all split in the middle so keys
+// never searched for still get a balanced subtree.
+template <typename Key, typename Value>
+std::size_t OptimalBinarySearchTreeBuilder<Key, Value>::weightMidpoint( std::size_t first, std::size_t last ) const
+{
+  if( weight( first, last ) <= 0.0 ) return first + ( last - first ) / 2;
+
+  auto imbalance = [&]( std::size_t r ) { return prefix_[r] + prefix_[r + 1] - prefix_[first] - prefix_[last]; };
+
+  std::size_t lo = first, hi = last - 1;                                   // find the first r with imbalance( r ) >= 0
+  while( lo < hi )
+  {
+    auto middle = lo + ( hi - lo ) / 2;
+    if( imbalance( middle ) < 0.0 ) lo = middle + 1;
+    else                            hi = middle;
+  }
+
+  if( lo > first  &&  -imbalance( lo - 1 ) < imbalance( lo ) ) --lo;
+  return lo;
+}
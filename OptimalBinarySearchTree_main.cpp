@@ -0,0 +1,107 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cmath>      // pow()
+#include <cstddef>    // size_t
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "OptimalBinarySearchTree.hpp"
+
+
+
+
+// A key that counts every comparison made against it, to measure what each tree shape costs a search
+struct CountedKey {
+  unsigned value_;
+
+  static inline std::size_t comparisons = 0;
+};
+
+bool operator< ( const CountedKey & lhs, const CountedKey & rhs ) { ++CountedKey::comparisons;  return lhs.value_ <  rhs.value_; }
+bool operator==( const CountedKey & lhs, const CountedKey & rhs ) { ++CountedKey::comparisons;  return lhs.value_ == rhs.value_; }
+std::ostream & operator<<( std::ostream & stream, const CountedKey & key ) { return stream << key.value_; }
+
+
+
+
+int main( int argc, char * argv[] ) {
+  // Chen's grade is looked up far more often than anyone else's, so the builder puts Chen at the root
+  OptimalBinarySearchTreeBuilder<std::string, double> builder;
+  builder.add( "Ricardo", 2.5,   10 );
+  builder.add( "Ellen",   3.5,   20 );
+  builder.add( "Chen",    2.5,  400 );
+  builder.add( "Kevin",   3.25,  15 );
+  builder.add( "Kumar",   3.05,  30 );
+
+  auto studentGrades = builder.build();
+  studentGrades.printInorder();
+  std::cout << "Expected nodes visited per lookup:  " << builder.expectedVisits() << '\n';   // (400 + 2*30 + 3*20 + 3*10 + 4*15) / 475 = 1.28
+  if( studentGrades.getHeight() != 3 ) std::cerr << "Tree height does not match expected\n";
+
+
+
+  // Usage:  OptimalBinarySearchTree [keys]      Access counts follow a Zipf distribution over keys in random order, like a log
+  //
+  // The exact (Knuth) tree is built and measured only for keys <= 4000;  at the default 100000 keys only the insertion order
+  // and weight balanced trees are compared.
+  std::size_t count    = argc > 1 ? std::atoi( argv[1] ) : 100000;
+  std::size_t searches = 1000000;
+  using Clock = std::chrono::steady_clock;
+
+  std::mt19937 generator( 131 );
+
+  std::vector<unsigned> popularity( count );                               // popularity[rank] = key with that rank
+  for( std::size_t i = 0; i < count; ++i )  popularity[i] = static_cast<unsigned>( i );
+  std::shuffle( popularity.begin(), popularity.end(), generator );
+
+  std::vector<double> weights( count );
+  for( std::size_t rank = 0; rank < count; ++rank )  weights[popularity[rank]] = 1.0 / std::pow( rank + 1.0, 1.1 );
+
+  std::discrete_distribution<unsigned> access( weights.begin(), weights.end() );
+  std::vector<CountedKey>              workload( searches );
+  for( auto & key : workload )  key.value_ = access( generator );
+
+  auto measure = [&]( const char * label, const BinarySearchTree<CountedKey, unsigned> & tree ) {
+    CountedKey::comparisons = 0;
+    unsigned checksum = 0;
+
+    auto start = Clock::now();
+    for( const auto & key : workload )  checksum += tree.search( key );
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+    std::cout << "  " << label << ":  height " << tree.getHeight() << ",  " << double( CountedKey::comparisons ) / searches << " comparisons/search,  "
+              << elapsed.count() / searches << " ns/search  (checksum " << checksum << ")\n";
+  };
+
+  std::cout << count << " keys, " << searches << " Zipf distributed searches\n";
+
+  // The approach being replaced:  insert in the order keys happen to arrive
+  std::vector<unsigned> arrival( popularity );
+  std::shuffle( arrival.begin(), arrival.end(), generator );
+
+  BinarySearchTree<CountedKey, unsigned> inserted;
+  for( auto key : arrival )  inserted.insert( { key }, key );
+  measure( "insertion order", inserted );
+
+  OptimalBinarySearchTreeBuilder<CountedKey, unsigned> weighted( 0 );      // exactLimit 0 forces Mehlhorn's approximation
+  for( std::size_t key = 0; key < count; ++key )  weighted.add( { static_cast<unsigned>( key ) }, static_cast<unsigned>( key ), weights[key] );
+  measure( "weight balanced", weighted.build() );
+
+  if( count <= 4000 )                                                      // Knuth's table needs ( count + 1 )^2 entries
+  {
+    OptimalBinarySearchTreeBuilder<CountedKey, unsigned> exact( count );
+    for( std::size_t key = 0; key < count; ++key )  exact.add( { static_cast<unsigned>( key ) }, static_cast<unsigned>( key ), weights[key] );
+    measure( "optimal", exact.build() );
+  }
+  else
+  {
+    std::cout << "  optimal:  skipped, the exact tree is only built for up to 4000 keys\n";
+  }
+}
+
+
+
+template class OptimalBinarySearchTreeBuilder<unsigned, float>;
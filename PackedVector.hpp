@@ -0,0 +1,360 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// An ExtendableVector of small unsigned integers, each stored in Bits bits packed into 64 bit
+// words: PackedVector<1> is a bitmap, 64 flags per word instead of one per byte, and
+// PackedVector<4> holds values 0 to 15 at 16 per word. Bits must divide 64, so no value ever
+// straddles two words.
+//
+// Elements are values, not objects, so operator[] and at() return copies; write with set().
+// Whole-vector operations work a word (64 / Bits elements) at a time: count() and find_first()
+// compare every field of a word with a value in a few instructions, and the &=, |= and ^=
+// operators combine bitmaps word by word. Those loops are simple enough for the compiler to
+// vectorize, e.g. into AVX-512 VPOPCNTQ (512 flags per instruction) given -mavx512vpopcntdq.
+//
+// Fields beyond size() are kept zero, so the word loops need no special case for the last word.
+
+// Declaration
+template <unsigned Bits = 1>
+class PackedVector {
+    static_assert(Bits >= 1 && Bits <= 32 && 64 % Bits == 0, "Bits must divide 64, and be at most 32");
+
+private:
+    static const size_t DEFAULT_CAPACITY = 1024;
+    static const size_t PER_WORD = 64 / Bits;                         // elements per word
+    static constexpr uint64_t FIELD = (uint64_t(1) << Bits) - 1;      // mask of one element's bits
+
+    size_t size_;
+    size_t capacity_;                                                 // in elements, a whole number of words
+    uint64_t* words_;
+
+public:
+    // Constructors
+    PackedVector(size_t arraysize = DEFAULT_CAPACITY);
+    PackedVector(const PackedVector& input);
+    PackedVector& operator=(const PackedVector& rhs); // Assignment operator
+    ~PackedVector(); // destructor
+
+    // Getters / Setters
+    uint64_t at(size_t index ) const;
+    uint64_t operator[](size_t index ) const;
+    void push_back(uint64_t value );            // values must fit in Bits bits, else range_error
+    void set(size_t index, uint64_t value );
+    void erase(size_t index );
+    void insert(size_t beforeIndex, uint64_t value);
+    size_t size() const;
+    bool empty() const;
+    void clear();
+
+    // Word at a time operations
+    size_t count(uint64_t value = 1) const;      // number of elements equal to value
+    size_t find_first(uint64_t value = 1) const; // index of the first element equal to value, or size() if none
+    PackedVector& operator&=(const PackedVector& rhs); // element-wise bit operations: sizes must match, else invalid_argument
+    PackedVector& operator|=(const PackedVector& rhs);
+    PackedVector& operator^=(const PackedVector& rhs);
+
+private:
+    void reserve(size_t); // helper function to change capacity
+    size_t wordCount() const;                        // words holding the elements
+    uint64_t equalFields(uint64_t word, uint64_t value) const; // the high bit of every field of word equal to value
+    uint64_t validFields(size_t word) const;         // the high bit of every field of word holding an element
+    static uint64_t checked(uint64_t value);
+    static unsigned popcount(uint64_t word);
+    static unsigned lowestBit(uint64_t word);
+};
+
+template <unsigned Bits>
+PackedVector<Bits> operator&(PackedVector<Bits> lhs, const PackedVector<Bits>& rhs) { return lhs &= rhs; }
+
+template <unsigned Bits>
+PackedVector<Bits> operator|(PackedVector<Bits> lhs, const PackedVector<Bits>& rhs) { return lhs |= rhs; }
+
+template <unsigned Bits>
+PackedVector<Bits> operator^(PackedVector<Bits> lhs, const PackedVector<Bits>& rhs) { return lhs ^= rhs; }
+
+// Constructor with initial capacity argument
+template <unsigned Bits>
+PackedVector<Bits>::PackedVector(size_t arraysize) {
+    size_ = 0;
+    capacity_ = (arraysize + PER_WORD - 1) / PER_WORD * PER_WORD;
+    words_ = new uint64_t[capacity_ / PER_WORD]();
+}
+
+template <unsigned Bits>
+size_t PackedVector<Bits>::size() const {
+    return size_;
+}
+
+template <unsigned Bits>
+bool PackedVector<Bits>::empty() const {
+    return (size_ == 0);
+}
+
+template <unsigned Bits>
+void PackedVector<Bits>::clear() {
+    for (size_t i = 0; i < wordCount(); i++) {
+        words_[i] = 0;
+    }
+    size_ = 0;
+}
+
+template <unsigned Bits>
+size_t PackedVector<Bits>::wordCount() const {
+    return (size_ + PER_WORD - 1) / PER_WORD;
+}
+
+template <unsigned Bits>
+uint64_t PackedVector<Bits>::checked(uint64_t value) {
+    if (value > FIELD) {
+        throw std::range_error("value does not fit in Bits bits");
+    }
+    return value;
+}
+
+// Getter
+template <unsigned Bits>
+uint64_t PackedVector<Bits>::at(size_t index) const {
+    if (index >= size_) {
+        throw std::range_error("index out of bounds");
+    }
+    return (*this)[index];
+}
+
+// Overloaded Array-Access Operator
+template <unsigned Bits>
+uint64_t PackedVector<Bits>::operator[](size_t index) const {
+    return (words_[index / PER_WORD] >> (index % PER_WORD * Bits)) & FIELD; // Note: array bounds intentionally not checking
+}
+
+// Setter
+template <unsigned Bits>
+void PackedVector<Bits>::set(size_t index, uint64_t value) {
+    if (index >= size_) {
+        throw std::range_error("index out of bounds");
+    }
+    const unsigned shift = index % PER_WORD * Bits;
+    uint64_t& word = words_[index / PER_WORD];
+    word = (word & ~(FIELD << shift)) | (checked(value) << shift);
+}
+
+template <unsigned Bits>
+void PackedVector<Bits>::push_back(uint64_t value) {
+    checked(value);
+    if (size_ >= capacity_) // If at max capacity, double the capacity
+        reserve (2 * capacity_ + PER_WORD);
+    size_++;
+    set(size_ - 1, value);
+}
+
+// Removes element from position. Elements from higher positions are shifted back to fill gap.
+// Vector size decrements. Whole words shift at once: each drops its lowest element into the top
+// of the word before it.
+template <unsigned Bits>
+void PackedVector<Bits>::erase(size_t index) {
+    if (index >= size_) {
+      throw std::range_error( "index out of bounds" );
+    }
+
+    const size_t first = index / PER_WORD;
+    const unsigned shift = index % PER_WORD * Bits;
+    const uint64_t below = (uint64_t(1) << shift) - 1;               // fields before index stay put
+    words_[first] = (words_[first] & below) | ((words_[first] >> Bits) & ~below);
+
+    for (size_t i = first + 1; i < wordCount(); i++) {
+        words_[i-1] |= (words_[i] & FIELD) << (64 - Bits);
+        words_[i] >>= Bits;
+    }
+    size_--;
+}
+
+// Copies x to element at position. Items at that position and higher are shifted over to make room. Vector size increments.
+template <unsigned Bits>
+void PackedVector<Bits>::insert(size_t beforeIndex, uint64_t value) {
+    if ( beforeIndex >  size_ ) {
+      throw std::range_error( "index out of bounds" );
+    }
+    checked(value);
+
+    if (size_ >= capacity_) // If at max capacity, double the capacity
+        reserve (2 * capacity_ + PER_WORD);
+    size_++;
+
+    // move whole words up one element, starting from the right and working left
+    const size_t first = beforeIndex / PER_WORD;
+    for (size_t i = wordCount() - 1; i > first; i--)
+        words_[i] = (words_[i] << Bits) | (words_[i-1] >> (64 - Bits));
+
+    const unsigned shift = beforeIndex % PER_WORD * Bits;
+    const uint64_t below = (uint64_t(1) << shift) - 1;
+    words_[first] = (words_[first] & below) | ((words_[first] & ~below) << Bits) | (value << shift);
+}
+
+template <unsigned Bits>
+void PackedVector<Bits>::reserve(size_t newCapacity) {
+    newCapacity = (newCapacity + PER_WORD - 1) / PER_WORD * PER_WORD;
+    if (newCapacity > capacity_) {
+        uint64_t* newWords = new uint64_t[newCapacity / PER_WORD]();
+        // Copy words to new array
+        for (size_t i = 0; i < wordCount(); i++) {
+            newWords[i] = words_[i];
+        }
+        delete[] words_;
+        words_ = newWords;
+        capacity_ = newCapacity;
+    }
+}
+
+// Word at a time search: XOR with value repeated in every field turns matching fields to zero.
+// Adding all ones below each field's high bit then carries into that bit exactly when the field's
+// low bits are not all zero (never into the next field), which with the field's own high bit
+// marks every nonzero field.
+template <unsigned Bits>
+uint64_t PackedVector<Bits>::equalFields(uint64_t word, uint64_t value) const {
+    const uint64_t lows = ~uint64_t(0) / FIELD;                       // the low bit of every field
+    const uint64_t highs = lows << (Bits - 1);                        // the high bit of every field
+    const uint64_t x = word ^ (value * lows);
+    const uint64_t nonzero = (((x & ~highs) + (highs - lows)) | x) & highs;
+    return ~nonzero & highs;
+}
+
+template <unsigned Bits>
+uint64_t PackedVector<Bits>::validFields(size_t word) const {
+    const uint64_t highs = (~uint64_t(0) / FIELD) << (Bits - 1);
+    const size_t used = size_ - word * PER_WORD;
+    return used >= PER_WORD ? highs : highs & ((uint64_t(1) << (used * Bits)) - 1);
+}
+
+template <unsigned Bits>
+size_t PackedVector<Bits>::count(uint64_t value) const {
+    if (value > FIELD) {
+        return 0;
+    }
+
+    size_t total = 0;
+    const size_t words = wordCount();
+    if (Bits == 1 && value == 1) { // a bitmap's set bits: padding is zero, so plain popcounts
+        for (size_t i = 0; i < words; i++) {
+            total += popcount(words_[i]);
+        }
+        return total;
+    }
+
+    for (size_t i = 0; i + 1 < words; i++) {
+        total += popcount(equalFields(words_[i], value));
+    }
+    if (words > 0) {
+        total += popcount(equalFields(words_[words - 1], value) & validFields(words - 1));
+    }
+    return total;
+}
+
+template <unsigned Bits>
+size_t PackedVector<Bits>::find_first(uint64_t value) const {
+    if (value > FIELD) {
+        return size_;
+    }
+
+    const size_t words = wordCount();
+    for (size_t i = 0; i < words; i++) {
+        uint64_t matches = equalFields(words_[i], value) & validFields(i);
+        if (matches != 0) {
+            return i * PER_WORD + lowestBit(matches) / Bits;
+        }
+    }
+    return size_;
+}
+
+template <unsigned Bits>
+PackedVector<Bits>& PackedVector<Bits>::operator&=(const PackedVector<Bits>& rhs) {
+    if (size_ != rhs.size_) {
+        throw std::invalid_argument("vector sizes differ");
+    }
+    for (size_t i = 0; i < wordCount(); i++) {
+        words_[i] &= rhs.words_[i];
+    }
+    return *this;
+}
+
+template <unsigned Bits>
+PackedVector<Bits>& PackedVector<Bits>::operator|=(const PackedVector<Bits>& rhs) {
+    if (size_ != rhs.size_) {
+        throw std::invalid_argument("vector sizes differ");
+    }
+    for (size_t i = 0; i < wordCount(); i++) {
+        words_[i] |= rhs.words_[i];
+    }
+    return *this;
+}
+
+template <unsigned Bits>
+PackedVector<Bits>& PackedVector<Bits>::operator^=(const PackedVector<Bits>& rhs) {
+    if (size_ != rhs.size_) {
+        throw std::invalid_argument("vector sizes differ");
+    }
+    for (size_t i = 0; i < wordCount(); i++) {
+        words_[i] ^= rhs.words_[i];
+    }
+    return *this;
+}
+
+template <unsigned Bits>
+unsigned PackedVector<Bits>::popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+    unsigned bits = 0;
+    for (; word != 0; word &= word - 1) {
+        bits++;
+    }
+    return bits;
+#endif
+}
+
+template <unsigned Bits>
+unsigned PackedVector<Bits>::lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Copy Constructor
+template <unsigned Bits>
+PackedVector<Bits>::PackedVector(const PackedVector<Bits>& input) {
+    size_ = input.size_;
+    capacity_ = input.capacity_;
+    words_ = new uint64_t[capacity_ / PER_WORD]();
+    for (size_t i = 0; i < wordCount(); i++) {
+        words_[i] = input.words_[i];
+    }
+}
+
+// Overloaded Assignment Operator
+template <unsigned Bits>
+PackedVector<Bits>& PackedVector<Bits>::operator=(const PackedVector<Bits>& rhs) {
+    if (this != &rhs) {
+        delete[] words_;
+        size_ = rhs.size_;
+        capacity_ = rhs.capacity_;
+        words_ = new uint64_t[capacity_ / PER_WORD]();
+        for (size_t i = 0; i < wordCount(); i++) {
+            words_[i] = rhs.words_[i];
+        }
+    }
+    return *this;
+}
+
+// Deconstructor
+template <unsigned Bits>
+PackedVector<Bits>::~PackedVector() {
+    delete[] words_;
+}
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "ExtendableVector.hpp"
+#include "PackedVector.hpp"
+using std::cout;
+using std::endl;
+
+int main() {
+    // Semesters completed by each student, 0 to 15: 16 students per 64 bit word
+    PackedVector<4> semesters;
+    semesters.push_back(2);   // Adam
+    semesters.push_back(1);   // Bob
+    semesters.push_back(3);   // Dolores
+    semesters.insert(2, 1);   // Carla, between Bob and Dolores
+    semesters.set(2, semesters[2] + 1);
+    semesters.erase(0);       // Adam graduates
+
+    for (size_t i = 0; i < semesters.size(); i++) {
+        cout << semesters[i] << ' ';  // 1 2 3
+    }
+    cout << endl;
+    if (semesters.count(2) != 1 || semesters.find_first(3) != 2 || semesters.find_first(7) != semesters.size()) {
+        std::cerr << "Packed vector contents do not match expected\n";
+    }
+
+
+    // Filter rows with two bitmaps: packed bits against one byte per flag
+    const size_t rows = size_t(1) << 26;
+    std::mt19937_64 random(42);
+    PackedVector<1> active(rows), recent(rows);
+    ExtendableVector<uint8_t> activeBytes(rows), recentBytes(rows);
+    for (size_t i = 0; i < rows; i++) {
+        uint64_t bits = random();
+        active.push_back(bits & 1);
+        recent.push_back((bits >> 1) & 1);
+        activeBytes.push_back(bits & 1);
+        recentBytes.push_back((bits >> 1) & 1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    active &= recent;
+    size_t packedMatches = active.count();
+    auto middle = std::chrono::steady_clock::now();
+    size_t byteMatches = 0;
+    for (size_t i = 0; i < rows; i++) {
+        activeBytes[i] &= recentBytes[i];
+        byteMatches += activeBytes[i];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    size_t firstSet = rows, firstClear = rows;
+    for (size_t i = 0; i < rows && (firstSet == rows || firstClear == rows); i++) {
+        if (activeBytes[i] && firstSet == rows) {
+            firstSet = i;
+        }
+        if (!activeBytes[i] && firstClear == rows) {
+            firstClear = i;
+        }
+    }
+
+    cout << "AND and count over " << rows << " rows: PackedVector<1> "
+         << std::chrono::duration<double>(middle - start).count() << " s, ExtendableVector<uint8_t> "
+         << std::chrono::duration<double>(end - middle).count() << " s" << endl;
+    if (packedMatches != byteMatches || active.find_first() != firstSet || active.find_first(0) != firstClear) {
+        std::cerr << "Bitmap filter does not match expected\n";
+    }
+}
@@ -0,0 +1,588 @@
+#pragma once
+#include <algorithm>      // copy(), copy_backward(), lower_bound(), upper_bound()
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t, uint64_t
+#include <cstring>        // memset()
+#include <fstream>
+#include <list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>    // is_trivially_copyable
+#include <unordered_map>
+#include <utility>        // pair
+#include <vector>
+
+// A B+ tree kept in a file of fixed size pages, for key sets too large to hold in memory as BinarySearchTree nodes.  Each
+// page is one tree node.  Inner nodes hold up to INNER_CAPACITY keys separating their children;  leaves hold the entries,
+// and each leaf links to the next one so a range scan walks leaves left to right without going back up the tree.  With 4 KB
+// pages and 8 byte keys and values a leaf holds 254 entries, so 500 million keys take about 2 million leaves (an 8 GB file)
+// under about 8 thousand inner nodes (32 MB).  A cache large enough for the inner nodes answers most lookups with one
+// page read.
+//
+// Pages move between the file and a fixed budget of memory frames (the page cache).  A page in use is pinned in its frame;
+// when a page is needed and no frame is free, the least recently used unpinned page is evicted, and written back first only if
+// it was modified.  Everything is written back on flush() and by the destructor, and the tree is reopened from the same file.
+//
+// Keys and values are written to disk byte for byte, so both must be trivially copyable (no std::string:  use a fixed size
+// character array).  Keys are unique:  inserting an existing key replaces its value.  remove() does not merge underfull
+// leaves;  later inserts reuse the room, and the file never shrinks.  Not thread safe.
+
+
+/*******************************************************************************
+**  Paged B+ Tree Abstract Data Type Definition (Duplicate keys not allowed)
+*******************************************************************************/
+template <typename Key, typename Value, std::size_t PageSize = 4096>
+class PagedBPlusTree {
+  static_assert( std::is_trivially_copyable<Key>::value  &&  std::is_trivially_copyable<Value>::value, "Keys and values are stored on disk byte for byte" );
+
+  public:
+    struct CacheStatistics {
+      std::size_t hits       = 0;                                          // page requests served from a frame
+      std::size_t misses     = 0;                                          // page requests that had to read the file (or allocate)
+      std::size_t pageReads  = 0;
+      std::size_t pageWrites = 0;
+    };
+
+    explicit PagedBPlusTree( const std::string & path, std::size_t cacheBytes = 64 * 1024 * 1024 );   // Opens path, or creates it.  Throws runtime_error on I/O failure or a mismatched file
+    PagedBPlusTree             ( const PagedBPlusTree & ) = delete;        // owns a file;  one tree object per file
+    PagedBPlusTree & operator= ( const PagedBPlusTree & ) = delete;
+   ~PagedBPlusTree             ();                                         // writes back every modified page
+
+    // Queries
+    Value       search   ( const Key & key )                       const;  // Throws invalid_argument if key not found
+    bool        contains ( const Key & key )                       const;
+    void        insert   ( const Key & key, const Value & value );         // Inserts key with value, or replaces the value if key is already present
+    void        remove   ( const Key & key );                              // Removes key if present, otherwise does nothing
+    std::size_t size     ()                                        const;
+    int         getHeight()                                        const;  // Returns the height of the tree, or -1 if tree is empty
+
+    template <typename Function>
+    void scan( const Key & lo, const Key & hi, Function visit )    const;  // Calls visit( key, value ) for every key in [lo, hi], ascending
+
+    void                    flush     ();                                  // Writes back every modified page and the file header
+    const CacheStatistics & statistics()                           const;
+
+
+  private:
+    using PageId = std::uint64_t;
+    static constexpr PageId        NO_PAGE = 0;                            // page 0 holds the file header, so no node ever lives there
+    static constexpr std::uint64_t MAGIC   = 0x31334350'42504C53ULL;
+
+    struct NodeHeader {
+      std::uint32_t leaf_;
+      std::uint32_t count_;                                                // keys in use
+      PageId        next_;                                                 // leaves:  the next leaf to the right, or NO_PAGE
+    };
+
+    static constexpr std::size_t LEAF_CAPACITY  = ( PageSize - sizeof( NodeHeader ) - alignof( Value  ) ) / ( sizeof( Key ) + sizeof( Value  ) );
+    static constexpr std::size_t INNER_CAPACITY = ( PageSize - sizeof( NodeHeader ) - alignof( PageId ) - sizeof( PageId ) ) / ( sizeof( Key ) + sizeof( PageId ) );
+
+    struct LeafNode {
+      NodeHeader header_;
+      Key        keys_  [LEAF_CAPACITY];
+      Value      values_[LEAF_CAPACITY];
+    };
+
+    struct InnerNode {                                                     // keys_[i] is the smallest key under children_[i + 1]
+      NodeHeader header_;
+      Key        keys_    [INNER_CAPACITY];
+      PageId     children_[INNER_CAPACITY + 1];
+    };
+
+    struct FileHeader {
+      std::uint64_t magic_;
+      PageId        root_;
+      std::uint64_t pageCount_;
+      std::uint64_t size_;
+      std::uint32_t levels_;
+      std::uint32_t pageSize_;
+      std::uint32_t keySize_;
+      std::uint32_t valueSize_;
+    };
+
+    static_assert( sizeof( LeafNode ) <= PageSize  &&  sizeof( InnerNode ) <= PageSize  &&  sizeof( FileHeader ) <= PageSize, "Node layout exceeds the page size" );
+    static_assert( LEAF_CAPACITY >= 3  &&  INNER_CAPACITY >= 3, "Page size too small for these keys and values" );
+
+    struct alignas(64) PageBuffer {
+      unsigned char bytes_[PageSize];
+    };
+
+    struct Frame {
+      PageId                                id_    = NO_PAGE;
+      bool                                  dirty_ = false;
+      unsigned                              pins_  = 0;
+      typename std::list<std::size_t>::iterator lruPosition_;
+    };
+
+    class PageGuard;                                                       // pins a page in its frame for the guard's lifetime
+
+    mutable std::fstream                            file_;
+    mutable std::vector<PageBuffer>                 buffers_;              // sized once:  frames never move
+    mutable std::vector<Frame>                      frames_;
+    mutable std::list<std::size_t>                  lru_;                  // frame indexes, most recently used first
+    mutable std::unordered_map<PageId, std::size_t> resident_;             // page -> frame holding it
+    mutable CacheStatistics                         statistics_;
+    FileHeader                                      header_;
+
+    // Helper functions
+    PageGuard   fetch       ( PageId page )                        const;
+    PageGuard   allocate    ();                                            // a new zeroed page at the end of the file
+    std::size_t claimFrame  ()                                     const;  // a free frame, evicting if necessary
+    void        readPage    ( PageId page, PageBuffer & buffer )   const;
+    void        writePage   ( PageId page, const PageBuffer & buffer ) const;
+    PageGuard   findLeaf    ( const Key & key )                    const;  // the leaf whose range covers key
+
+    std::optional<std::pair<Key, PageId>> insert( PageId page, const Key & key, const Value & value );   // returns the separator and new right sibling if page split
+};
+
+
+/*******************************************************************************
+**  Page Guard Definition
+*******************************************************************************/
+template <typename Key, typename Value, std::size_t PageSize>
+class PagedBPlusTree<Key, Value, PageSize>::PageGuard {
+  public:
+    PageGuard( const PagedBPlusTree * tree, std::size_t frame ) : tree_( tree ), frame_( frame ) { ++tree_->frames_[frame_].pins_; }
+    PageGuard( PageGuard && other ) : tree_( other.tree_ ), frame_( other.frame_ )                { other.tree_ = nullptr; }
+    PageGuard & operator=( PageGuard && other )                                                    { std::swap( tree_, other.tree_ );  std::swap( frame_, other.frame_ );  return *this; }
+    PageGuard            ( const PageGuard & ) = delete;
+   ~PageGuard()                                                                                    { if( tree_ != nullptr ) --tree_->frames_[frame_].pins_; }
+
+    PageId      id   () const { return tree_->frames_[frame_].id_; }
+    NodeHeader & node() const { return *reinterpret_cast<NodeHeader *>( tree_->buffers_[frame_].bytes_ ); }
+    LeafNode  & leaf () const { return *reinterpret_cast<LeafNode   *>( tree_->buffers_[frame_].bytes_ ); }
+    InnerNode & inner() const { return *reinterpret_cast<InnerNode  *>( tree_->buffers_[frame_].bytes_ ); }
+    void        dirty() const { tree_->frames_[frame_].dirty_ = true; }
+
+
+  private:
+    const PagedBPlusTree * tree_;
+    std::size_t            frame_;
+};
+
+
+/*******************************************************************************
+**  PagedBPlusTree<Key, Value, PageSize>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Page cache
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t PageSize>
+typename PagedBPlusTree<Key, Value, PageSize>::PageGuard PagedBPlusTree<Key, Value, PageSize>::fetch( PageId page ) const
+{
+  auto resident = resident_.find( page );
+  if( resident != resident_.end() )
+  {
+    ++statistics_.hits;
+    auto & frame = frames_[resident->second];
+    lru_.splice( lru_.begin(), lru_, frame.lruPosition_ );
+    return PageGuard( this, resident->second );
+  }
+
+  ++statistics_.misses;
+  auto index = claimFrame();
+  readPage( page, buffers_[index] );
+
+  frames_[index].id_ = page;
+  resident_[page]    = index;
+  return PageGuard( this, index );
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+typename PagedBPlusTree<Key, Value, PageSize>::PageGuard PagedBPlusTree<Key, Value, PageSize>::allocate()
+{
+  ++statistics_.misses;
+  auto index = claimFrame();
+  auto page  = header_.pageCount_++;
+
+  std::memset( buffers_[index].bytes_, 0, PageSize );
+  frames_[index].id_    = page;
+  frames_[index].dirty_ = true;
+  resident_[page]       = index;
+  return PageGuard( this, index );
+}
+
+
+
+
+// Uses a never used frame while there is one, otherwise the least recently used frame not pinned by a guard.  The frame comes
+// back at the front of the LRU list, as it is about to be used.
+template <typename Key, typename Value, std::size_t PageSize>
+std::size_t PagedBPlusTree<Key, Value, PageSize>::claimFrame() const
+{
+  if( frames_.size() < buffers_.size() )
+  {
+    frames_.emplace_back();
+    lru_.push_front( frames_.size() - 1 );
+    frames_.back().lruPosition_ = lru_.begin();
+    return frames_.size() - 1;
+  }
+
+  for( auto position = lru_.rbegin(); position != lru_.rend(); ++position )
+  {
+    auto & frame = frames_[*position];
+    if( frame.pins_ != 0 ) continue;
+
+    if( frame.dirty_ ) writePage( frame.id_, buffers_[*position] );
+    resident_.erase( frame.id_ );
+    frame.id_    = NO_PAGE;
+    frame.dirty_ = false;
+
+    lru_.splice( lru_.begin(), lru_, frame.lruPosition_ );
+    return lru_.front();
+  }
+
+  throw std::length_error( "Every cached page is in use:  the page cache is too small" );
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+void PagedBPlusTree<Key, Value, PageSize>::readPage( PageId page, PageBuffer & buffer ) const
+{
+  ++statistics_.pageReads;
+  file_.seekg( static_cast<std::streamoff>( page * PageSize ) );
+  file_.read( reinterpret_cast<char *>( buffer.bytes_ ), PageSize );
+
+  if( !file_ ) { file_.clear();  throw std::runtime_error( "Page read failed" ); }
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+void PagedBPlusTree<Key, Value, PageSize>::writePage( PageId page, const PageBuffer & buffer ) const
+{
+  ++statistics_.pageWrites;
+  file_.seekp( static_cast<std::streamoff>( page * PageSize ) );
+  file_.write( reinterpret_cast<const char *>( buffer.bytes_ ), PageSize );
+
+  if( !file_ ) { file_.clear();  throw std::runtime_error( "Page write failed" ); }
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+void PagedBPlusTree<Key, Value, PageSize>::flush()
+{
+  for( std::size_t i = 0; i < frames_.size(); ++i )
+  {
+    if( !frames_[i].dirty_ ) continue;
+
+    writePage( frames_[i].id_, buffers_[i] );
+    frames_[i].dirty_ = false;
+  }
+
+  PageBuffer headerPage{};
+  *reinterpret_cast<FileHeader *>( headerPage.bytes_ ) = header_;
+  writePage( 0, headerPage );
+
+  file_.flush();
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+const typename PagedBPlusTree<Key, Value, PageSize>::CacheStatistics & PagedBPlusTree<Key, Value, PageSize>::statistics() const
+{ return statistics_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+// Each step releases the parent's pin as the child is pinned, so a search holds at most two frames
+template <typename Key, typename Value, std::size_t PageSize>
+typename PagedBPlusTree<Key, Value, PageSize>::PageGuard PagedBPlusTree<Key, Value, PageSize>::findLeaf( const Key & key ) const
+{
+  auto guard = fetch( header_.root_ );
+
+  while( !guard.node().leaf_ )
+  {
+    auto & inner = guard.inner();
+    auto   child = std::upper_bound( inner.keys_, inner.keys_ + inner.header_.count_, key ) - inner.keys_;
+    guard        = fetch( inner.children_[child] );
+  }
+
+  return guard;
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+Value PagedBPlusTree<Key, Value, PageSize>::search( const Key & key ) const
+{
+  if( header_.root_ != NO_PAGE )
+  {
+    auto   guard    = findLeaf( key );
+    auto & leaf     = guard.leaf();
+    auto   position = std::lower_bound( leaf.keys_, leaf.keys_ + leaf.header_.count_, key );
+
+    if( position != leaf.keys_ + leaf.header_.count_  &&  *position == key ) return leaf.values_[position - leaf.keys_];
+  }
+
+  throw std::invalid_argument( "Key not found" );
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+bool PagedBPlusTree<Key, Value, PageSize>::contains( const Key & key ) const
+{
+  if( header_.root_ == NO_PAGE ) return false;
+
+  auto   guard    = findLeaf( key );
+  auto & leaf     = guard.leaf();
+  auto   position = std::lower_bound( leaf.keys_, leaf.keys_ + leaf.header_.count_, key );
+
+  return position != leaf.keys_ + leaf.header_.count_  &&  *position == key;
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+template <typename Function>
+void PagedBPlusTree<Key, Value, PageSize>::scan( const Key & lo, const Key & hi, Function visit ) const
+{
+  if( header_.root_ == NO_PAGE ) return;
+
+  auto        guard    = findLeaf( lo );
+  std::size_t position = std::lower_bound( guard.leaf().keys_, guard.leaf().keys_ + guard.node().count_, lo ) - guard.leaf().keys_;
+
+  while( true )
+  {
+    auto & leaf = guard.leaf();
+    for( ; position < leaf.header_.count_; ++position )
+    {
+      if( hi < leaf.keys_[position] ) return;
+      visit( leaf.keys_[position], leaf.values_[position] );
+    }
+
+    if( leaf.header_.next_ == NO_PAGE ) return;
+    guard    = fetch( leaf.header_.next_ );
+    position = 0;
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t PageSize>
+void PagedBPlusTree<Key, Value, PageSize>::insert( const Key & key, const Value & value )
+{
+  if( header_.root_ == NO_PAGE )                                           // Insert first entry
+  {
+    auto guard = allocate();
+    guard.node().leaf_ = 1;
+    header_.root_      = guard.id();
+    header_.levels_    = 1;
+  }
+
+  auto split = insert( header_.root_, key, value );
+  if( !split ) return;
+
+  auto   guard = allocate();                                               // the root split:  grow a new root above both halves
+  auto & root  = guard.inner();
+  root.header_.count_ = 1;
+  root.keys_[0]       = split->first;
+  root.children_[0]   = header_.root_;
+  root.children_[1]   = split->second;
+
+  header_.root_ = guard.id();
+  ++header_.levels_;
+}
+
+
+
+
+// Inserts below page.  A full node splits in half:  a leaf copies its right half's first key up as the separator, an inner
+// node moves its middle key up, and the caller adds the separator and the new right node to its own page.
+template <typename Key, typename Value, std::size_t PageSize>
+std::optional<std::pair<Key, typename PagedBPlusTree<Key, Value, PageSize>::PageId>>
+PagedBPlusTree<Key, Value, PageSize>::insert( PageId page, const Key & key, const Value & value )
+{
+  auto guard = fetch( page );
+
+  if( guard.node().leaf_ )
+  {
+    auto & leaf     = guard.leaf();
+    auto   count    = leaf.header_.count_;
+    auto   position = std::lower_bound( leaf.keys_, leaf.keys_ + count, key ) - leaf.keys_;
+
+    guard.dirty();
+    if( position < count  &&  leaf.keys_[position] == key )                // Replace existing value
+    {
+      leaf.values_[position] = value;
+      return std::nullopt;
+    }
+
+    ++header_.size_;
+    if( count < LEAF_CAPACITY )
+    {
+      std::copy_backward( leaf.keys_   + position, leaf.keys_   + count, leaf.keys_   + count + 1 );
+      std::copy_backward( leaf.values_ + position, leaf.values_ + count, leaf.values_ + count + 1 );
+      leaf.keys_  [position] = key;
+      leaf.values_[position] = value;
+      ++leaf.header_.count_;
+      return std::nullopt;
+    }
+
+    std::vector<Key>   keys  ( leaf.keys_,   leaf.keys_   + count );       // Split:  lay out all count + 1 entries, then deal them out
+    std::vector<Value> values( leaf.values_, leaf.values_ + count );
+    keys  .insert( keys  .begin() + position, key   );
+    values.insert( values.begin() + position, value );
+
+    auto   rightGuard = allocate();
+    auto & right      = rightGuard.leaf();
+    auto   half       = keys.size() / 2;
+
+    std::copy( keys  .begin(),        keys  .begin() + half, leaf.keys_    );
+    std::copy( values.begin(),        values.begin() + half, leaf.values_  );
+    std::copy( keys  .begin() + half, keys  .end(),          right.keys_   );
+    std::copy( values.begin() + half, values.end(),          right.values_ );
+
+    right.header_.leaf_  = 1;
+    right.header_.count_ = static_cast<std::uint32_t>( keys.size() - half );
+    right.header_.next_  = leaf.header_.next_;
+    leaf .header_.count_ = static_cast<std::uint32_t>( half );
+    leaf .header_.next_  = rightGuard.id();
+
+    return std::make_pair( right.keys_[0], rightGuard.id() );
+  }
+
+  std::size_t child = std::upper_bound( guard.inner().keys_, guard.inner().keys_ + guard.node().count_, key ) - guard.inner().keys_;
+  auto        split = insert( guard.inner().children_[child], key, value );
+  if( !split ) return std::nullopt;
+
+  auto & inner = guard.inner();
+  auto   count = inner.header_.count_;
+  guard.dirty();
+
+  if( count < INNER_CAPACITY )
+  {
+    std::copy_backward( inner.keys_     + child,     inner.keys_     + count,     inner.keys_     + count + 1 );
+    std::copy_backward( inner.children_ + child + 1, inner.children_ + count + 1, inner.children_ + count + 2 );
+    inner.keys_    [child]     = split->first;
+    inner.children_[child + 1] = split->second;
+    ++inner.header_.count_;
+    return std::nullopt;
+  }
+
+  std::vector<Key>    keys    ( inner.keys_,     inner.keys_     + count     );
+  std::vector<PageId> children( inner.children_, inner.children_ + count + 1 );
+  keys    .insert( keys    .begin() + child,     split->first  );
+  children.insert( children.begin() + child + 1, split->second );
+
+  auto   rightGuard = allocate();
+  auto & right      = rightGuard.inner();
+  auto   middle     = keys.size() / 2;                                     // moves up, kept by neither half
+
+  std::copy( keys    .begin(),              keys    .begin() + middle,     inner.keys_     );
+  std::copy( children.begin(),              children.begin() + middle + 1, inner.children_ );
+  std::copy( keys    .begin() + middle + 1, keys    .end(),                right.keys_     );
+  std::copy( children.begin() + middle + 1, children.end(),                right.children_ );
+
+  right.header_.count_ = static_cast<std::uint32_t>( keys.size() - middle - 1 );
+  inner.header_.count_ = static_cast<std::uint32_t>( middle );
+
+  return std::make_pair( keys[middle], rightGuard.id() );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t PageSize>
+void PagedBPlusTree<Key, Value, PageSize>::remove( const Key & key )
+{
+  if( header_.root_ == NO_PAGE ) return;
+
+  auto   guard    = findLeaf( key );
+  auto & leaf     = guard.leaf();
+  auto   count    = leaf.header_.count_;
+  auto   position = std::lower_bound( leaf.keys_, leaf.keys_ + count, key ) - leaf.keys_;
+
+  if( position == count  ||  !( leaf.keys_[position] == key ) ) return;   // Not found
+
+  std::copy( leaf.keys_   + position + 1, leaf.keys_   + count, leaf.keys_   + position );
+  std::copy( leaf.values_ + position + 1, leaf.values_ + count, leaf.values_ + position );
+  --leaf.header_.count_;
+  --header_.size_;
+  guard.dirty();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Size, height
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t PageSize>
+std::size_t PagedBPlusTree<Key, Value, PageSize>::size() const
+{ return header_.size_; }
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+int PagedBPlusTree<Key, Value, PageSize>::getHeight() const
+{ return header_.size_ == 0 ? -1 : static_cast<int>( header_.levels_ ) - 1; }     // an emptied tree still keeps its root leaf
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, std::size_t PageSize>
+PagedBPlusTree<Key, Value, PageSize>::PagedBPlusTree( const std::string & path, std::size_t cacheBytes )
+  : buffers_( std::max<std::size_t>( cacheBytes / PageSize, 16 ) )         // room for a root to leaf path during a split, and then some
+{
+  frames_.reserve( buffers_.size() );
+
+  file_.open( path, std::ios::in | std::ios::out | std::ios::binary );
+  if( !file_.is_open() )                                                   // Create the file
+  {
+    file_.clear();
+    file_.open( path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc );
+    if( !file_.is_open() ) throw std::runtime_error( "Cannot create " + path );
+
+    header_ = { MAGIC, NO_PAGE, 1, 0, 0, PageSize, sizeof( Key ), sizeof( Value ) };
+    flush();
+    return;
+  }
+
+  PageBuffer headerPage;
+  readPage( 0, headerPage );
+  header_ = *reinterpret_cast<const FileHeader *>( headerPage.bytes_ );
+
+  if( header_.magic_ != MAGIC  ||  header_.pageSize_ != PageSize  ||  header_.keySize_ != sizeof( Key )  ||  header_.valueSize_ != sizeof( Value ) )
+    throw std::runtime_error( path + " is not a tree of this key, value and page size" );
+}
+
+
+
+
+template <typename Key, typename Value, std::size_t PageSize>
+PagedBPlusTree<Key, Value, PageSize>::~PagedBPlusTree()
+{
+  try                              { flush(); }
+  catch( const std::exception & ) {}                                       // destructors must not throw;  call flush() first to see errors
+}
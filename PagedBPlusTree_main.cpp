@@ -0,0 +1,101 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cstdio>     // remove()
+#include <cstdlib>    // atoi()
+#include <cstring>    // strncpy(), strncmp()
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "PagedBPlusTree.hpp"
+
+
+
+
+// Pages are written byte for byte, so names are stored as fixed size character arrays rather than std::string
+struct StudentName {
+  char name_[16];
+
+  StudentName( const char * name = "" ) { std::strncpy( name_, name, sizeof( name_ ) ); }
+};
+
+bool operator< ( const StudentName & lhs, const StudentName & rhs ) { return std::strncmp( lhs.name_, rhs.name_, sizeof( lhs.name_ ) ) <  0; }
+bool operator==( const StudentName & lhs, const StudentName & rhs ) { return std::strncmp( lhs.name_, rhs.name_, sizeof( lhs.name_ ) ) == 0; }
+
+
+
+
+int main( int argc, char * argv[] ) {
+  {
+    PagedBPlusTree<StudentName, double> studentGrades( "studentGrades.db" );
+    studentGrades.insert("Ricardo", 2.5);
+    studentGrades.insert("Ellen", 3.5);
+    studentGrades.insert("Chen", 2.5);
+    studentGrades.insert("Kevin", 3.25);
+    studentGrades.insert("Kumar", 3.05);
+  }                                                                        // destructor writes the pages out
+
+  {
+    PagedBPlusTree<StudentName, double> studentGrades( "studentGrades.db" );   // ... and they are read back in
+    std::cout << "Grade of Ellen is " << studentGrades.search( "Ellen" ) << '\n';
+
+    std::cout << "Students from \"Ch\" to \"Kevin\":";                     // Chen Ellen Kevin
+    studentGrades.scan( "Ch", "Kevin", []( const StudentName & student, double ) { std::cout << ' ' << student.name_; } );
+    std::cout << '\n';
+
+    if( studentGrades.size() != 5  ||  studentGrades.getHeight() != 0 ) std::cerr << "Reopened tree does not match expected\n";
+  }
+  std::remove( "studentGrades.db" );
+
+
+
+  // Usage:  PagedBPlusTree [keys [cache MB]]      Random inserts and lookups through a page cache smaller than the tree
+  std::size_t count     = argc > 1 ? std::atoi( argv[1] ) : 4000000;
+  std::size_t cacheSize = argc > 2 ? std::atoi( argv[2] ) : 16;
+  std::size_t lookups   = 1000000;
+  using Clock = std::chrono::steady_clock;
+
+  std::mt19937_64 generator( 131 );
+  std::vector<unsigned long long> keys( count );
+  for( auto & key : keys )  key = generator();
+
+  {
+    PagedBPlusTree<unsigned long long, unsigned long long> tree( "PagedBPlusTree.db", cacheSize * 1024 * 1024 );
+
+    auto start = Clock::now();
+    for( auto key : keys )  tree.insert( key, ~key );
+    tree.flush();
+    std::chrono::duration<double, std::nano> insertTime = Clock::now() - start;
+
+    auto written = tree.statistics().pageWrites;
+    std::cout << count << " keys (" << count * 16 / ( 1024 * 1024 ) << " MB of entries), " << cacheSize << " MB page cache:  height " << tree.getHeight() << '\n'
+              << "  insert:  " << insertTime.count() / count << " ns/key,  " << written << " pages written\n";
+
+    auto before = tree.statistics();
+    std::size_t mismatches = 0;
+    start = Clock::now();
+    for( std::size_t i = 0; i < lookups; ++i )
+    {
+      auto key = keys[generator() % count];
+      if( tree.search( key ) != ~key ) ++mismatches;
+    }
+    std::chrono::duration<double, std::nano> searchTime = Clock::now() - start;
+
+    auto after = tree.statistics();
+    std::cout << "  search:  " << searchTime.count() / lookups << " ns/key,  " << double( after.pageReads - before.pageReads ) / lookups << " page reads/search,  "
+              << 100.0 * ( after.hits - before.hits ) / ( after.hits - before.hits + after.misses - before.misses ) << "% cache hits\n";
+
+    std::size_t scanned = 0;
+    start = Clock::now();
+    tree.scan( 0, ~0ULL / 100, [&]( unsigned long long, unsigned long long ) { ++scanned; } );             // the lowest 1% of the key space
+    std::chrono::duration<double, std::nano> scanTime = Clock::now() - start;
+    std::cout << "  scan:    " << scanned << " keys in order,  " << scanTime.count() / scanned << " ns/key\n";
+
+    if( mismatches != 0 ) std::cerr << "Search results do not match inserted values\n";
+  }
+  std::remove( "PagedBPlusTree.db" );
+}
+
+
+
+template class PagedBPlusTree<unsigned, float>;
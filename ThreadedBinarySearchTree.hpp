@@ -0,0 +1,483 @@
+#pragma once
+#include <algorithm>  // max(), swap()
+#include <cstddef>    // size_t
+#include <iostream>
+#include <stdexcept>
+
+// A threaded binary search tree:  a left_ or right_ link that would otherwise be null instead points at the node's in-order
+// predecessor or successor, and a flag on the node records which links are such "threads" rather than children.  Walking
+// the tree in order then needs neither recursion, an explicit stack, nor parent pointers:
+//
+//   successor( node ) =  node->right_                            if right_ is a thread
+//                        leftmost node of node's right subtree   otherwise
+//
+// so a full scan follows each link at most twice (O(1) amortized per step), and stepping from a node whose right_ is a thread,
+// which is every leaf, is a single load.  Iterators are bidirectional and stay valid across inserts and across removes of
+// other keys.  The two ends of the order thread to nullptr.
+
+
+/*******************************************************************************
+**  Threaded Binary Search Tree Node Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+struct ThreadedNode {
+  // Constructors
+  ThreadedNode( const Key & key = Key(),  const Value & value = Value() );   // Also serves as the default constructor
+
+  // Public instance attributes
+  Key   key_;
+  Value value_;
+
+  // Private instance attributes
+  ThreadedNode * left_        = nullptr;                                   // child, or in-order predecessor when leftThread_
+  ThreadedNode * right_       = nullptr;                                   // child, or in-order successor   when rightThread_
+  bool           leftThread_  = true;
+  bool           rightThread_ = true;
+};
+
+template <typename Key, typename Value>
+std::ostream & operator<<( std::ostream & stream, const ThreadedNode<Key, Value> & node );
+
+
+/*******************************************************************************
+**  Threaded Binary Search Tree Abstract Data Type Definition (Duplicate keys allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class ThreadedBinarySearchTree {
+  using Node = ThreadedNode<Key, Value>;
+
+  public:
+    class Iterator;
+
+    ThreadedBinarySearchTree             () = default;
+    ThreadedBinarySearchTree             ( const ThreadedBinarySearchTree & original );   // performs a deep copy
+    ThreadedBinarySearchTree & operator= (       ThreadedBinarySearchTree   rhs      );   // performs a deep copy assignment  NOTE: INTENTIONALLY PASSED BY VALUE (delegates to copy constructor)
+   ~ThreadedBinarySearchTree             ();                                              // performs a deep node destruction
+
+    // Queries
+    Value       search      ( const Key & key )                       const;  // Returns the value associated with the first node found matching given key. Throws invalid_argument if key not found
+    void        insert      ( const Key & key, const Value & value );         // Inserts a new leaf, threading it between its in-order neighbours
+    void        remove      ( const Key & key );                              // Removes the first-found matching node, re-threading its neighbours
+    void        printInorder()                                        const;  // Prints the contents of the tree in ascending sorted order, without recursion
+    int         getHeight   ()                                        const;  // Returns the height of the tree, or -1 if tree is empty
+    std::size_t size        ()                                        const;
+
+    template <typename Function>
+    void visitInorder( Function visit )                               const;  // Calls visit( key, value ) for every node in ascending key order, without recursion
+
+    Iterator begin()                                                  const;  // Smallest key
+    Iterator last ()                                                  const;  // Largest key
+    Iterator end  ()                                                  const;  // One past either end
+
+    void clear();                                                             // Returns the tree to an empty state releasing all nodes
+
+
+  private:
+    Node *      root_ = nullptr;
+    std::size_t size_ = 0;
+
+    // Helper functions
+    static Node * leftmost   ( Node * node );
+    static Node * rightmost  ( Node * node );
+    static Node * successor  ( Node * node );
+    static Node * predecessor( Node * node );
+
+    Node * makeCopy ( Node * originalNode, Node * predecessor, Node * successor );   // Copy constructor helper function
+    int    getHeight( Node * node )                                       const;
+};
+
+
+/*******************************************************************************
+**  Threaded Binary Search Tree Iterator Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+class ThreadedBinarySearchTree<Key, Value>::Iterator {
+  public:
+    const ThreadedNode<Key, Value> & operator* ()                      const { return *node_; }
+    const ThreadedNode<Key, Value> * operator->()                      const { return  node_; }
+
+    Iterator & operator++()                                                  { node_ = successor  ( node_ );  return *this; }
+    Iterator & operator--()                                                  { node_ = predecessor( node_ );  return *this; }
+
+    bool operator==( const Iterator & rhs )                            const { return node_ == rhs.node_; }
+    bool operator!=( const Iterator & rhs )                            const { return node_ != rhs.node_; }
+
+
+  private:
+    friend class ThreadedBinarySearchTree;
+    explicit Iterator( Node * node ) : node_( node ) {}
+
+    Node * node_;
+};
+
+
+/*******************************************************************************
+**  ThreadedBinarySearchTree<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value ThreadedBinarySearchTree<Key, Value>::search( const Key & key ) const
+{
+  auto cur = root_;
+
+  while( cur != nullptr )
+  {
+    if     ( key == cur->key_ )  return cur->value_;                     // Found
+    else if( key  < cur->key_ )  cur = cur->leftThread_  ? nullptr : cur->left_;
+    else                         cur = cur->rightThread_ ? nullptr : cur->right_;
+  }
+
+  throw std::invalid_argument( "Key not found" );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+// The new node always becomes a leaf, so its in-order neighbours are its parent and whatever the parent's link on that side
+// threaded to before
+template <typename Key, typename Value>
+void ThreadedBinarySearchTree<Key, Value>::insert( const Key & key, const Value & value )
+{
+  auto node = new Node( key, value );
+  ++size_;
+
+  if( root_ == nullptr )                                                  // Insert first node
+  {
+    root_ = node;
+    return;
+  }
+
+  auto cur = root_;
+  while( true )                                                           // Search for insertion point, starting with the root
+  {
+    if( node->key_ < cur->key_ )
+    {
+      if( cur->leftThread_ )                                              // Found left insertion point
+      {
+        node->left_      = cur->left_;                                    // cur's old predecessor
+        node->right_     = cur;
+        cur->left_       = node;
+        cur->leftThread_ = false;
+        return;
+      }
+      cur = cur->left_;
+    }
+
+    else   // node->key_ >= cur->key_   (This algorithm allows duplicate keys)
+    {
+      if( cur->rightThread_ )                                             // Found right insertion point
+      {
+        node->right_      = cur->right_;                                  // cur's old successor
+        node->left_       = cur;
+        cur->right_       = node;
+        cur->rightThread_ = false;
+        return;
+      }
+      cur = cur->right_;
+    }
+  }
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+// Without parent pointers the search remembers the parent itself.  A node with two children is replaced by its successor (the
+// leftmost node of its right subtree, which has no left child):  the successor is unlinked from where it was and relinked,
+// node and all, in the removed node's place, so no other node's key or value moves and iterators to them stay valid.  Unlinking
+// a node with at most one child splices the child into its place;  the only threads that pointed at the node are then the
+// predecessor's right_ and the successor's left_, which are redirected past it.
+template <typename Key, typename Value>
+void ThreadedBinarySearchTree<Key, Value>::remove( const Key & key )
+{
+  Node * parent = nullptr;
+  auto   node   = root_;
+
+  while( node != nullptr  &&  !( key == node->key_ ) )
+  {
+    parent = node;
+    if( key < node->key_ ) node = node->leftThread_  ? nullptr : node->left_;
+    else                   node = node->rightThread_ ? nullptr : node->right_;
+  }
+
+  if( node == nullptr ) return;                                           // Not found
+
+  // Case 1: Internal node with 2 children
+  if( !node->leftThread_  &&  !node->rightThread_ )
+  {
+    Node * succParent = node;
+    auto   succNode   = node->right_;
+    while( !succNode->leftThread_ ) { succParent = succNode;  succNode = succNode->left_; }
+
+    if( succParent != node )                                              // Unlink the successor, splicing in its right subtree
+    {
+      if( succNode->rightThread_ ) { succParent->left_ = succNode;  succParent->leftThread_ = true; }   // succNode stays succParent's predecessor
+      else                           succParent->left_ = succNode->right_;
+
+      succNode->right_       = node->right_;
+      succNode->rightThread_ = false;
+    }
+
+    succNode->left_       = node->left_;                                  // Adopt node's left subtree, whose rightmost node threaded to node
+    succNode->leftThread_ = false;
+    rightmost( node->left_ )->right_ = succNode;
+
+    if( parent == nullptr )                                   root_          = succNode;
+    else if( parent->left_ == node  &&  !parent->leftThread_ ) parent->left_  = succNode;
+    else                                                       parent->right_ = succNode;
+
+    delete node;
+    --size_;
+    return;
+  }
+
+  // Case 2: node has at most one child
+  Node * child;
+
+  if( node->leftThread_  &&  node->rightThread_ )                         // Leaf:  the parent's link becomes a thread past it
+  {
+    child = nullptr;
+  }
+  else if( !node->leftThread_ )                                           // Left child only:  the predecessor threaded right to node
+  {
+    child = node->left_;
+    rightmost( child )->right_ = node->right_;
+  }
+  else                                                                    // Right child only:  the successor threaded left to node
+  {
+    child = node->right_;
+    leftmost( child )->left_ = node->left_;
+  }
+
+  if( parent == nullptr )                          root_ = child;
+  else if( parent->left_ == node  &&  !parent->leftThread_ )
+  {
+    if( child == nullptr ) { parent->left_ = node->left_;   parent->leftThread_  = true; }
+    else                     parent->left_ = child;
+  }
+  else
+  {
+    if( child == nullptr ) { parent->right_ = node->right_; parent->rightThread_ = true; }
+    else                     parent->right_ = child;
+  }
+
+  delete node;
+  --size_;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  In-order traversal
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+ThreadedNode<Key, Value> * ThreadedBinarySearchTree<Key, Value>::leftmost( Node * node )
+{
+  if( node != nullptr ) while( !node->leftThread_ ) node = node->left_;
+  return node;
+}
+
+
+
+
+template <typename Key, typename Value>
+ThreadedNode<Key, Value> * ThreadedBinarySearchTree<Key, Value>::rightmost( Node * node )
+{
+  if( node != nullptr ) while( !node->rightThread_ ) node = node->right_;
+  return node;
+}
+
+
+
+
+template <typename Key, typename Value>
+ThreadedNode<Key, Value> * ThreadedBinarySearchTree<Key, Value>::successor( Node * node )
+{
+  if( node->rightThread_ ) return node->right_;
+  return leftmost( node->right_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+ThreadedNode<Key, Value> * ThreadedBinarySearchTree<Key, Value>::predecessor( Node * node )
+{
+  if( node->leftThread_ ) return node->left_;
+  return rightmost( node->left_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+typename ThreadedBinarySearchTree<Key, Value>::Iterator ThreadedBinarySearchTree<Key, Value>::begin() const
+{ return Iterator( leftmost( root_ ) ); }
+
+
+
+
+template <typename Key, typename Value>
+typename ThreadedBinarySearchTree<Key, Value>::Iterator ThreadedBinarySearchTree<Key, Value>::last() const
+{ return Iterator( rightmost( root_ ) ); }
+
+
+
+
+template <typename Key, typename Value>
+typename ThreadedBinarySearchTree<Key, Value>::Iterator ThreadedBinarySearchTree<Key, Value>::end() const
+{ return Iterator( nullptr ); }
+
+
+
+
+template <typename Key, typename Value>
+template <typename Function>
+void ThreadedBinarySearchTree<Key, Value>::visitInorder( Function visit ) const
+{
+  for( auto node = leftmost( root_ ); node != nullptr; node = successor( node ) )  visit( node->key_, node->value_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+void ThreadedBinarySearchTree<Key, Value>::printInorder() const
+{
+  for( auto node = leftmost( root_ ); node != nullptr; node = successor( node ) )  std::cout << *node;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Height, size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+int ThreadedBinarySearchTree<Key, Value>::getHeight() const
+{
+  return getHeight( root_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+int ThreadedBinarySearchTree<Key, Value>::getHeight( Node * node ) const
+{
+  if( node == nullptr ) return -1;
+
+  auto leftHeight  = node->leftThread_  ? -1 : getHeight( node->left_  );
+  auto rightHeight = node->rightThread_ ? -1 : getHeight( node->right_ );
+
+  return 1 + std::max( leftHeight, rightHeight );
+}
+
+
+
+
+template <typename Key, typename Value>
+std::size_t ThreadedBinarySearchTree<Key, Value>::size() const
+{ return size_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+ThreadedBinarySearchTree<Key, Value>::ThreadedBinarySearchTree( const ThreadedBinarySearchTree & original )
+  : size_( original.size_ )
+{ root_ = makeCopy( original.root_, nullptr, nullptr ); }
+
+
+
+
+// Copies the subtree whose in-order neighbours outside of it are predecessor and successor, which is exactly where its
+// leftmost node's and rightmost node's outer threads must point
+template <typename Key, typename Value>
+ThreadedNode<Key, Value> * ThreadedBinarySearchTree<Key, Value>::makeCopy( Node * originalNode, Node * predecessor, Node * successor )
+{
+  if( originalNode == nullptr ) return nullptr;
+
+  auto node = new Node( originalNode->key_, originalNode->value_ );
+
+  node->leftThread_  = originalNode->leftThread_;
+  node->rightThread_ = originalNode->rightThread_;
+  node->left_        = node->leftThread_  ? predecessor : makeCopy( originalNode->left_,  predecessor, node      );
+  node->right_       = node->rightThread_ ? successor   : makeCopy( originalNode->right_, node,        successor );
+
+  return node;
+}
+
+
+
+
+// Passing by value delegates copying the tree to the copy constructor, keeping the "copy" knowledge
+// in one place.  (Copy and swap idiom)
+template <typename Key, typename Value>
+ThreadedBinarySearchTree<Key, Value> & ThreadedBinarySearchTree<Key, Value>::operator=( ThreadedBinarySearchTree rhs )
+{
+  std::swap( root_, rhs.root_ );
+  std::swap( size_, rhs.size_ );
+
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Value>
+ThreadedBinarySearchTree<Key, Value>::~ThreadedBinarySearchTree()
+{ clear(); }
+
+
+
+
+// Deletes in order:  a node's successor is found through links into nodes that come later in the order, none of which are
+// deleted yet
+template <typename Key, typename Value>
+void ThreadedBinarySearchTree<Key, Value>::clear()
+{
+  auto node = leftmost( root_ );
+  while( node != nullptr )
+  {
+    auto next = successor( node );
+    delete node;
+    node = next;
+  }
+
+  root_ = nullptr;
+  size_ = 0;
+}
+
+
+
+
+/*******************************************************************************
+**  ThreadedNode<Key, Value>  Definitions
+*******************************************************************************/
+template <typename Key, typename Value>
+ThreadedNode<Key, Value>::ThreadedNode( const Key & key, const Value & value )
+  : key_( key ), value_( value )
+{}
+
+
+
+
+template <typename Key, typename Value>
+std::ostream & operator<<( std::ostream & stream, const ThreadedNode<Key, Value> & node )
+{
+  stream << "Key: \"" << node.key_ << "\",  Value: \"" << node.value_ << "\"\n";
+  return stream;
+}
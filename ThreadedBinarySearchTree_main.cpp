@@ -0,0 +1,77 @@
+#include <algorithm>  // shuffle()
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "ThreadedBinarySearchTree.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  ThreadedBinarySearchTree<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  auto gradeBook = studentGrades; // test copy constructor, threads are copied too
+
+  studentGrades.printInorder();
+
+  std::cout << "Descending:";
+  for( auto student = studentGrades.last(); student != studentGrades.end(); --student )  std::cout << ' ' << student->key_;
+  std::cout << '\n';
+
+  if( studentGrades.getHeight() != 3 ) std::cerr << "Tree height does not match expected\n";
+
+  gradeBook.remove( "Ellen" );
+  if( gradeBook.getHeight() != 2  ||  gradeBook.begin()->key_ != "Chen"  ||  ( ++gradeBook.begin() )->key_ != "Kevin" ) std::cerr << "Remove did not match expected\n";
+
+
+
+  // Usage:  ThreadedBinarySearchTree [keys]
+  std::size_t count  = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  std::size_t passes = 10;
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<unsigned> keys( count );
+  for( std::size_t i = 0; i < count; ++i )  keys[i] = static_cast<unsigned>( i );
+  std::shuffle( keys.begin(), keys.end(), std::mt19937( 131 ) );
+
+  BinarySearchTree<unsigned, unsigned>         plain;
+  ThreadedBinarySearchTree<unsigned, unsigned> threaded;
+  for( auto key : keys ) { plain.insert( key, key );  threaded.insert( key, key ); }
+
+  unsigned long long checksum = 0;
+
+  // The approach being replaced:  recursive in-order traversal.  Its call stack remembers every ancestor, so on large trees the
+  // processor can fetch a parent while still finishing the left subtree;  a threaded walk learns each next node only from the
+  // node before it.  What threading buys is iteration with one pointer of state and no recursion depth limit.
+  auto start = Clock::now();
+  for( std::size_t pass = 0; pass < passes; ++pass )  plain.visitInorder( [&]( unsigned key, unsigned ) { checksum += key; } );
+  std::chrono::duration<double, std::nano> recursiveTime = Clock::now() - start;
+
+  start = Clock::now();
+  for( std::size_t pass = 0; pass < passes; ++pass )  threaded.visitInorder( [&]( unsigned key, unsigned ) { checksum -= key; } );
+  std::chrono::duration<double, std::nano> threadedTime = Clock::now() - start;
+
+  start = Clock::now();
+  for( std::size_t pass = 0; pass < passes; ++pass )
+    for( auto node = threaded.begin(); node != threaded.end(); ++node )  checksum += node->key_;
+  std::chrono::duration<double, std::nano> iteratorTime = Clock::now() - start;
+
+  std::cout << count << " keys, in-order scan:  recursive " << recursiveTime.count() / ( passes * count ) << " ns/key,  threaded "
+            << threadedTime.count() / ( passes * count ) << " ns/key,  threaded iterator " << iteratorTime.count() / ( passes * count ) << " ns/key\n";
+
+  if( checksum != passes * ( count * ( count - 1 ) / 2 ) ) std::cerr << "Scans did not visit every key\n";
+}
+
+
+
+template class ThreadedBinarySearchTree<unsigned, float>;
@@ -0,0 +1,436 @@
+#pragma once
+#include <algorithm>  // max(), swap()
+#include <cstddef>    // size_t
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// A binary search tree with lazy deletion.  remove() only marks the node it finds as dead (a "tombstone"):  no successor
+// search, no copying, no relinking, so its cost is just the search.  Lookups and traversals step over dead nodes, and an
+// insert that meets a dead node with its own key brings that node back to life instead of allocating a new one.
+//
+// Dead nodes still cost memory and lengthen searches, so compact() physically removes all of them in one O(n) pass, and
+// rebuilds the surviving nodes into a perfectly balanced tree while it is at it.  By default compaction is left entirely to
+// the caller, e.g. to run it during a quiet period.  A compactionThreshold below 1 has remove() run compact() itself once dead
+// nodes make up more than that fraction of the tree:  amortized O(1) per remove, but the remove that crosses the threshold
+// stalls for the whole O(n) pass (about 200 ms for a million keys in the demo).
+//
+// Lazy removal does not make the average remove cheaper:  most of a remove is the search, and dead nodes keep the tree at its
+// full height until compacted.  In the demo, removing half of a million shuffled keys measures no faster than
+// BinarySearchTree's eager remove, and in most runs slower on both the mean and the 99th percentile.  What it buys is a
+// remove that never relinks or frees a node, and a restructuring cost that lands where the caller chooses.
+//
+// Equal keys are kept to the right of one another (as BinarySearchTree's inserts do), and compact() preserves that, so a
+// search only ever has to continue right past a dead node holding its key.
+
+
+/*******************************************************************************
+**  Tombstone Binary Search Tree Node Definition
+*******************************************************************************/
+template <typename Key, typename Value>
+struct TombstoneNode {
+  // Constructors
+  TombstoneNode( const Key & key = Key(),  const Value & value = Value() );   // Also serves as the default constructor
+
+  // Public instance attributes
+  Key   key_;
+  Value value_;
+
+  // Private instance attributes
+  TombstoneNode * left_  = nullptr;
+  TombstoneNode * right_ = nullptr;
+  bool            dead_  = false;
+};
+
+template <typename Key, typename Value>
+std::ostream & operator<<( std::ostream & stream, const TombstoneNode<Key, Value> & node );
+
+
+/*******************************************************************************
+**  Tombstone Binary Search Tree Abstract Data Type Definition (Duplicate keys allowed)
+*******************************************************************************/
+template <typename Key, typename Value>
+class TombstoneBinarySearchTree {
+  using Node = TombstoneNode<Key, Value>;
+
+  public:
+    explicit TombstoneBinarySearchTree   ( double compactionThreshold = 1.0 );           // Throws invalid_argument unless 0 < compactionThreshold <= 1;  1 never compacts from remove()
+    TombstoneBinarySearchTree            ( const TombstoneBinarySearchTree & original );  // performs a deep copy
+    TombstoneBinarySearchTree & operator=(       TombstoneBinarySearchTree   rhs      );  // performs a deep copy assignment  NOTE: INTENTIONALLY PASSED BY VALUE (delegates to copy constructor)
+   ~TombstoneBinarySearchTree            ();                                             // performs a deep node destruction
+
+    // Queries
+    Value       search      ( const Key & key )                       const;  // Returns the value of the first live node found matching given key. Throws invalid_argument if key not found
+    void        insert      ( const Key & key, const Value & value );         // Revives a dead node with this key if the search passes one, otherwise inserts a new leaf
+    void        remove      ( const Key & key );                              // Marks the first-found live matching node dead
+    void        printInorder()                                        const;  // Prints the live contents of the tree in ascending sorted order
+    int         getHeight   ()                                        const;  // Returns the height of the tree, dead nodes included, or -1 if tree is empty
+    std::size_t size        ()                                        const;  // Live nodes
+    std::size_t deadCount   ()                                        const;  // Dead nodes awaiting compaction
+
+    template <typename Function>
+    void visitInorder( Function visit )                               const;  // Calls visit( key, value ) for every live node in ascending key order
+
+    void compact();                                                           // Releases every dead node and rebalances the rest
+    void clear  ();                                                           // Returns the tree to an empty state releasing all nodes
+
+
+  private:
+    Node *      root_      = nullptr;
+    std::size_t size_      = 0;
+    std::size_t deadCount_ = 0;
+    double      compactionThreshold_;
+
+    // Helper functions
+    Node * find         ( const Key & key )                       const;     // First live node matching key, or nullptr
+    void   clear        ( Node * node );
+    void   printInorder ( Node * node )                           const;
+    int    getHeight    ( Node * node )                           const;
+    void   collectLive  ( Node * node, std::vector<Node *> & live );         // Appends live nodes in order, deleting dead ones
+    Node * buildBalanced( std::vector<Node *> & live, std::size_t first, std::size_t last );
+    Node * makeCopy     ( Node * originalNode );                             // Copy constructor helper function
+
+    template <typename Function>
+    void   visitInorder ( Node * node, Function & visit )         const;
+};
+
+
+/*******************************************************************************
+**  TombstoneBinarySearchTree<Key, Value>  Definitions
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//  Search
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+Value TombstoneBinarySearchTree<Key, Value>::search( const Key & key ) const
+{
+  auto node = find( key );
+
+  if( node == nullptr ) throw std::invalid_argument( "Key not found" );
+  return node->value_;
+}
+
+
+
+
+template <typename Key, typename Value>
+TombstoneNode<Key, Value> * TombstoneBinarySearchTree<Key, Value>::find( const Key & key ) const
+{
+  auto cur = root_;
+
+  while( cur != nullptr )
+  {
+    if     ( key < cur->key_ )                    cur = cur->left_;
+    else if( key == cur->key_  &&  !cur->dead_ )  return cur;               // Found
+    else                                          cur = cur->right_;        // greater, or a tombstone whose duplicates lie right
+  }
+
+  return nullptr; // Not found
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::insert( const Key & key, const Value & value )
+{
+  ++size_;
+
+  Node ** link = &root_;                                                  // the child link the search is about to follow
+  while( *link != nullptr )
+  {
+    auto cur = *link;
+
+    if( key < cur->key_ )
+    {
+      link = &cur->left_;
+    }
+    else if( cur->dead_  &&  key == cur->key_ )                            // Reuse the tombstone
+    {
+      cur->value_ = value;
+      cur->dead_  = false;
+      --deadCount_;
+      return;
+    }
+    else
+    {
+      link = &cur->right_;                                                // (This algorithm allows duplicate keys)
+    }
+  }
+
+  *link = new Node( key, value );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::remove( const Key & key )
+{
+  auto node = find( key );
+  if( node == nullptr ) return;
+
+  node->dead_ = true;
+  --size_;
+  ++deadCount_;
+
+  if( deadCount_ > compactionThreshold_ * ( size_ + deadCount_ ) ) compact();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compaction
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::compact()
+{
+  std::vector<Node *> live;
+  live.reserve( size_ );
+
+  collectLive( root_, live );
+
+  root_      = buildBalanced( live, 0, live.size() );
+  deadCount_ = 0;
+}
+
+
+
+
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::collectLive( Node * node, std::vector<Node *> & live )
+{
+  if( node == nullptr ) return;
+
+  collectLive( node->left_, live );
+  auto right = node->right_;
+
+  if( node->dead_ ) delete node;
+  else              live.push_back( node );
+
+  collectLive( right, live );
+}
+
+
+
+
+// Roots each range at its middle node, except that the root moves left to the first of any run of equal keys so that equal
+// keys still only ever sit to the right of one another
+template <typename Key, typename Value>
+TombstoneNode<Key, Value> * TombstoneBinarySearchTree<Key, Value>::buildBalanced( std::vector<Node *> & live, std::size_t first, std::size_t last )
+{
+  if( first >= last ) return nullptr;
+
+  auto middle = first + ( last - first ) / 2;
+  while( middle > first  &&  !( live[middle - 1]->key_ < live[middle]->key_ ) ) --middle;
+
+  auto node    = live[middle];
+  node->left_  = buildBalanced( live, first,      middle );
+  node->right_ = buildBalanced( live, middle + 1, last   );
+
+  return node;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Print, visit
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::printInorder() const
+{
+  printInorder( root_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::printInorder( Node * node ) const
+{
+  if( node == nullptr ) return;
+
+  printInorder( node->left_ );
+  if( !node->dead_ ) std::cout << *node;
+  printInorder( node->right_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+template <typename Function>
+void TombstoneBinarySearchTree<Key, Value>::visitInorder( Function visit ) const
+{
+  visitInorder( root_, visit );
+}
+
+
+
+
+template <typename Key, typename Value>
+template <typename Function>
+void TombstoneBinarySearchTree<Key, Value>::visitInorder( Node * node, Function & visit ) const
+{
+  if( node == nullptr ) return;
+
+  visitInorder( node->left_, visit );
+  if( !node->dead_ ) visit( node->key_, node->value_ );
+  visitInorder( node->right_, visit );
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Height, size
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+int TombstoneBinarySearchTree<Key, Value>::getHeight() const
+{
+  return getHeight( root_ );
+}
+
+
+
+
+template <typename Key, typename Value>
+int TombstoneBinarySearchTree<Key, Value>::getHeight( Node * node ) const
+{
+  if( node == nullptr ) return -1;
+
+  auto leftHeight  = getHeight( node->left_  );
+  auto rightHeight = getHeight( node->right_ );
+
+  return 1 + std::max( leftHeight, rightHeight );
+}
+
+
+
+
+template <typename Key, typename Value>
+std::size_t TombstoneBinarySearchTree<Key, Value>::size() const
+{ return size_; }
+
+
+
+
+template <typename Key, typename Value>
+std::size_t TombstoneBinarySearchTree<Key, Value>::deadCount() const
+{ return deadCount_; }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+//   Constructors, destructor, assignments
+////////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+TombstoneBinarySearchTree<Key, Value>::TombstoneBinarySearchTree( double compactionThreshold )
+  : compactionThreshold_( compactionThreshold )
+{
+  if( !( compactionThreshold > 0.0  &&  compactionThreshold <= 1.0 ) ) throw std::invalid_argument( "Compaction threshold must be within (0, 1]" );
+}
+
+
+
+
+template <typename Key, typename Value>
+TombstoneBinarySearchTree<Key, Value>::TombstoneBinarySearchTree( const TombstoneBinarySearchTree & original )
+  : size_( original.size_ ), deadCount_( original.deadCount_ ), compactionThreshold_( original.compactionThreshold_ )
+{ root_ = makeCopy( original.root_ ); }
+
+
+
+
+template <typename Key, typename Value>
+TombstoneNode<Key, Value> * TombstoneBinarySearchTree<Key, Value>::makeCopy( Node * originalNode )
+{
+  if( originalNode == nullptr ) return nullptr;
+
+  auto node    = new Node( originalNode->key_, originalNode->value_ );
+  node->dead_  = originalNode->dead_;
+  node->left_  = makeCopy( originalNode->left_ );
+  node->right_ = makeCopy( originalNode->right_ );
+
+  return node;
+}
+
+
+
+
+// Passing by value delegates copying the tree to the copy constructor, keeping the "copy" knowledge
+// in one place.  (Copy and swap idiom)
+template <typename Key, typename Value>
+TombstoneBinarySearchTree<Key, Value> & TombstoneBinarySearchTree<Key, Value>::operator=( TombstoneBinarySearchTree rhs )
+{
+  std::swap( root_,                rhs.root_                );
+  std::swap( size_,                rhs.size_                );
+  std::swap( deadCount_,           rhs.deadCount_           );
+  std::swap( compactionThreshold_, rhs.compactionThreshold_ );
+
+  return *this;
+}
+
+
+
+
+template <typename Key, typename Value>
+TombstoneBinarySearchTree<Key, Value>::~TombstoneBinarySearchTree()
+{ clear(); }
+
+
+
+
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::clear()
+{
+  clear( root_ );
+  root_      = nullptr;
+  size_      = 0;
+  deadCount_ = 0;
+}
+
+
+
+
+template <typename Key, typename Value>
+void TombstoneBinarySearchTree<Key, Value>::clear( Node * node )
+{
+  if( node == nullptr ) return;
+
+  clear( node->left_ );
+  clear( node->right_ );
+
+  delete node;
+}
+
+
+
+
+/*******************************************************************************
+**  TombstoneNode<Key, Value>  Definitions
+*******************************************************************************/
+template <typename Key, typename Value>
+TombstoneNode<Key, Value>::TombstoneNode( const Key & key, const Value & value )
+  : key_( key ), value_( value )
+{}
+
+
+
+
+template <typename Key, typename Value>
+std::ostream & operator<<( std::ostream & stream, const TombstoneNode<Key, Value> & node )
+{
+  stream << "Key: \"" << node.key_ << "\",  Value: \"" << node.value_ << "\"\n";
+  return stream;
+}
@@ -0,0 +1,112 @@
+#include <algorithm>  // shuffle(), sort()
+#include <chrono>
+#include <cstdlib>    // atoi()
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.hpp"
+#include "TombstoneBinarySearchTree.hpp"
+
+
+
+
+int main( int argc, char * argv[] ) {
+  TombstoneBinarySearchTree<std::string, double> studentGrades;
+  studentGrades.insert("Ricardo", 2.5);
+  studentGrades.insert("Ellen", 3.5);
+  studentGrades.insert("Chen", 2.5);
+  studentGrades.insert("Kevin", 3.25);
+  studentGrades.insert("Kumar", 3.05);
+
+  studentGrades.remove( "Ellen" );                                         // only marked dead:  the shape is unchanged
+  if( studentGrades.getHeight() != 3  ||  studentGrades.size() != 4  ||  studentGrades.deadCount() != 1 ) std::cerr << "Remove did not match expected\n";
+
+  studentGrades.insert( "Ellen", 3.75 );                                   // revives the tombstone
+  studentGrades.remove( "Kumar" );
+  studentGrades.compact();                                                 // Chen Ellen Kevin Ricardo, balanced
+  if( studentGrades.getHeight() != 2  ||  studentGrades.deadCount() != 0  ||  studentGrades.search( "Ellen" ) != 3.75 ) std::cerr << "Compaction did not match expected\n";
+
+  studentGrades.printInorder();
+
+
+
+  // Usage:  TombstoneBinarySearchTree [keys]      Removes half of the keys, timing each remove
+  //
+  // Either way most of a remove is the search for the key, and a tombstoned tree keeps its full height until compacted, so
+  // tombstones do not make removes faster:  at a million keys expect their mean and p99 to come out at or above
+  // BinarySearchTree's.  What tombstones change is where the restructuring cost lands:  nothing is unlinked or freed inside
+  // remove(), and the work moves into compact(), run here either at a time of the caller's choosing (the default) or from
+  // remove() at a threshold, where it shows up as one very long remove.
+  std::size_t count = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+  using Clock = std::chrono::steady_clock;
+
+  std::mt19937 generator( 131 );
+  std::vector<unsigned> keys( count );
+  for( std::size_t i = 0; i < count; ++i )  keys[i] = static_cast<unsigned>( i );
+  std::shuffle( keys.begin(), keys.end(), generator );
+
+  std::vector<unsigned> victims( keys.begin(), keys.begin() + count / 2 );
+  std::shuffle( victims.begin(), victims.end(), generator );
+
+  auto report = [&]( const char * label, std::vector<double> & latencies ) {
+    std::sort( latencies.begin(), latencies.end() );
+    double total = 0.0;
+    for( auto latency : latencies )  total += latency;
+
+    std::cout << "  " << label << ":  mean " << total / latencies.size() << " ns,  p99 " << latencies[latencies.size() * 99 / 100]
+              << " ns,  max " << latencies.back() / 1000.0 << " us\n";
+  };
+
+  std::cout << count << " keys, removing " << victims.size() << ":\n";
+  std::vector<double> latencies( victims.size() );
+
+  {  // The approach being replaced:  restructure on every remove
+    BinarySearchTree<unsigned, unsigned> tree;
+    for( auto key : keys )  tree.insert( key, key );
+
+    for( std::size_t i = 0; i < victims.size(); ++i )
+    {
+      auto start = Clock::now();
+      tree.remove( victims[i] );
+      latencies[i] = std::chrono::duration<double, std::nano>( Clock::now() - start ).count();
+    }
+    report( "BinarySearchTree           ", latencies );
+  }
+
+  {  // Compaction left to the caller (the default), run once the burst of removes is over
+    TombstoneBinarySearchTree<unsigned, unsigned> tree;
+    for( auto key : keys )  tree.insert( key, key );
+
+    for( std::size_t i = 0; i < victims.size(); ++i )
+    {
+      auto start = Clock::now();
+      tree.remove( victims[i] );
+      latencies[i] = std::chrono::duration<double, std::nano>( Clock::now() - start ).count();
+    }
+    report( "Tombstones, explicit compact", latencies );
+
+    auto start = Clock::now();
+    tree.compact();
+    std::chrono::duration<double, std::milli> compactTime = Clock::now() - start;
+    std::cout << "    compact():  " << compactTime.count() << " ms,  height " << tree.getHeight() << ",  " << tree.size() << " live keys\n";
+  }
+
+  {  // Compaction from remove() once a quarter of the tree is dead
+    TombstoneBinarySearchTree<unsigned, unsigned> tree( 0.25 );
+    for( auto key : keys )  tree.insert( key, key );
+
+    for( std::size_t i = 0; i < victims.size(); ++i )
+    {
+      auto start = Clock::now();
+      tree.remove( victims[i] );
+      latencies[i] = std::chrono::duration<double, std::nano>( Clock::now() - start ).count();
+    }
+    report( "Tombstones, threshold 0.25 ", latencies );
+  }
+}
+
+
+
+template class TombstoneBinarySearchTree<unsigned, float>;